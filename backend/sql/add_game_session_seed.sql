@@ -0,0 +1,6 @@
+-- Record the client's RNG seed with each game session so runs can be
+-- replayed and scores validated server-side
+
+-- 64-bit seed as 16 lowercase hex digits (too wide for a JS number)
+ALTER TABLE game_sessions 
+ADD COLUMN IF NOT EXISTS rng_seed VARCHAR(16) CHECK (rng_seed ~ '^[0-9a-f]{16}$');
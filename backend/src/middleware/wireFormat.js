@@ -0,0 +1,50 @@
+const express = require('express');
+const msgpack = require('../utils/msgpack');
+const cbor = require('../utils/cbor');
+
+// Binary encodings the game client may use instead of JSON for telemetry
+// (sessions, progress, batches). The request's Content-Type says how its
+// body is encoded; Accept says how the client wants the response.
+const FORMATS = {
+  'application/msgpack': msgpack,
+  'application/cbor': cbor
+};
+const BINARY_TYPES = Object.keys(FORMATS);
+
+// Reads a binary body (gzip inflated by express.raw) into req.body, as
+// express.json does for JSON ones
+const rawBody = express.raw({ type: BINARY_TYPES, limit: '10mb' });
+
+function parseBinaryBody(req, res, next) {
+  rawBody(req, res, (err) => {
+    if (err) return next(err);
+
+    const format = FORMATS[req.is(BINARY_TYPES)];
+    if (!format || !Buffer.isBuffer(req.body)) return next();
+
+    try {
+      req.body = format.decode(req.body);
+    } catch (error) {
+      return res.status(400).json({
+        error: 'Malformed request body'
+      });
+    }
+    if (req.body === null || typeof req.body !== 'object' || Array.isArray(req.body)) {
+      return res.status(400).json({
+        error: 'Request body must be an object'
+      });
+    }
+    next();
+  });
+}
+
+// Responds with 'body' in whichever supported format the client prefers
+function sendBody(req, res, status, body) {
+  const type = req.accepts(['application/json', ...BINARY_TYPES]);
+  if (!FORMATS[type]) {
+    return res.status(status).json(body);
+  }
+  res.status(status).type(type).send(FORMATS[type].encode(body));
+}
+
+module.exports = { parseBinaryBody, sendBody };
@@ -4,42 +4,49 @@ const GameSessionService = require('../services/GameSessionService');
 const ScoreService = require('../services/ScoreService');
 const supabase = require('../config/supabase');
 const { authMiddleware } = require('../middleware/auth');
+const { sendBody } = require('../middleware/wireFormat');
 
 // All routes require authentication
 router.use(authMiddleware);
 
-// Start a new game session
-router.post('/session/start', async (req, res) => {
+// Route bodies shared by the single-event routes and /batch; each
+// resolves to the { status, body } the single-event route responds with
+
+async function startSession(user, params) {
   try {
-    const { gameMode = 'normal' } = req.body;
-    const userId = req.user.id;
+    const { gameMode = 'normal', seed = null } = params;
+    const userId = user.id;
 
-    console.log(`Starting session for user ${userId}, mode: ${gameMode}`);
+    // RNG seed the client will spawn from: 16 hex digits (64 bits don't fit a JS number)
+    if (seed !== null && !/^[0-9a-f]{16}$/.test(seed)) {
+      return { status: 400, body: { error: 'Seed must be 16 lowercase hex digits' } };
+    }
+
+    console.log(`Starting session for user ${userId}, mode: ${gameMode}, seed: ${seed}`);
 
-    const result = await GameSessionService.startSession(userId, gameMode);
+    const result = await GameSessionService.startSession(userId, gameMode, seed);
 
     if (!result.success) {
-      return res.status(400).json({
-        error: result.error
-      });
+      return { status: 400, body: { error: result.error } };
     }
 
-    res.json({
-      success: true,
-      sessionId: result.sessionId,
-      profileId: result.profileId,
-      message: 'Game session started successfully'
-    });
+    return {
+      status: 200,
+      body: {
+        success: true,
+        sessionId: result.sessionId,
+        profileId: result.profileId,
+        seed: result.seed,
+        message: 'Game session started successfully'
+      }
+    };
   } catch (error) {
     console.error('Error starting game session:', error);
-    res.status(500).json({
-      error: 'Failed to start game session'
-    });
+    return { status: 500, body: { error: 'Failed to start game session' } };
   }
-});
+}
 
-// Save game progress during session
-router.post('/progress/save', async (req, res) => {
+async function saveProgress(user, params) {
   try {
     const {
       sessionId,
@@ -52,12 +59,10 @@ router.post('/progress/save', async (req, res) => {
       damageDealt,
       damageTaken,
       waveReached
-    } = req.body;
+    } = params;
 
     if (!sessionId) {
-      return res.status(400).json({
-        error: 'Session ID is required'
-      });
+      return { status: 400, body: { error: 'Session ID is required' } };
     }
 
     const result = await GameSessionService.saveProgress(sessionId, {
@@ -73,25 +78,17 @@ router.post('/progress/save', async (req, res) => {
     });
 
     if (!result.success) {
-      return res.status(400).json({
-        error: result.error
-      });
+      return { status: 400, body: { error: result.error } };
     }
 
-    res.json({
-      success: true,
-      message: 'Progress saved successfully'
-    });
+    return { status: 200, body: { success: true, message: 'Progress saved successfully' } };
   } catch (error) {
     console.error('Error saving progress:', error);
-    res.status(500).json({
-      error: 'Failed to save progress'
-    });
+    return { status: 500, body: { error: 'Failed to save progress' } };
   }
-});
+}
 
-// End game session and save all scores
-router.post('/session/end', async (req, res) => {
+async function endSession(user, params) {
   try {
     const {
       sessionId,
@@ -105,15 +102,13 @@ router.post('/session/end', async (req, res) => {
       damageTaken,
       waveReached,
       endReason
-    } = req.body;
+    } = params;
 
     if (!sessionId) {
-      return res.status(400).json({
-        error: 'Session ID is required'
-      });
+      return { status: 400, body: { error: 'Session ID is required' } };
     }
 
-    console.log(`Ending session ${sessionId} for user ${req.user.id}`);
+    console.log(`Ending session ${sessionId} for user ${user.id}`);
 
     const result = await GameSessionService.endSession(sessionId, {
       finalScore: finalScore || 0,
@@ -129,25 +124,146 @@ router.post('/session/end', async (req, res) => {
     });
 
     if (!result.success) {
-      return res.status(400).json({
-        error: result.error
-      });
+      return { status: 400, body: { error: result.error } };
     }
 
-    res.json({
-      success: true,
-      sessionId: result.sessionId,
-      profileId: result.profileId,
-      scoresResult: result.scoresResult,
-      message: 'Game session ended and scores saved successfully'
-    });
+    return {
+      status: 200,
+      body: {
+        success: true,
+        sessionId: result.sessionId,
+        profileId: result.profileId,
+        scoresResult: result.scoresResult,
+        message: 'Game session ended and scores saved successfully'
+      }
+    };
   } catch (error) {
     console.error('Error ending game session:', error);
-    res.status(500).json({
-      error: 'Failed to end game session'
-    });
+    return { status: 500, body: { error: 'Failed to end game session' } };
   }
-});
+}
+
+async function saveNormalScore(user, params) {
+  try {
+    const { sessionId, scoreData } = params;
+
+    // Get user's profile
+    const { data: profile } = await supabase
+      .from('profiles')
+      .select('id')
+      .eq('user_id', user.id)
+      .single();
+
+    if (!profile) {
+      return { status: 404, body: { error: 'User profile not found' } };
+    }
+
+    const result = await ScoreService.saveNormalScore(profile.id, sessionId, scoreData);
+
+    if (!result.success) {
+      return { status: 400, body: { error: result.error } };
+    }
+
+    return {
+      status: 200,
+      body: {
+        success: true,
+        normalScore: result.normalScore,
+        isPersonalBest: result.isPersonalBest
+      }
+    };
+  } catch (error) {
+    console.error('Error saving normal score:', error);
+    return { status: 500, body: { error: 'Failed to save normal score' } };
+  }
+}
+
+async function saveLeaderboardScore(user, params) {
+  try {
+    const { sessionId, leaderboardData } = params;
+
+    // Get user's profile
+    const { data: profile } = await supabase
+      .from('profiles')
+      .select('id')
+      .eq('user_id', user.id)
+      .single();
+
+    if (!profile) {
+      return { status: 404, body: { error: 'User profile not found' } };
+    }
+
+    const result = await ScoreService.saveLeaderboardScore(profile.id, sessionId, leaderboardData);
+
+    if (!result.success) {
+      return { status: 400, body: { error: result.error } };
+    }
+
+    return {
+      status: 200,
+      body: {
+        success: true,
+        leaderboardScore: result.leaderboardScore,
+        newTotal: result.newTotal
+      }
+    };
+  } catch (error) {
+    console.error('Error saving leaderboard score:', error);
+    return { status: 500, body: { error: 'Failed to save leaderboard score' } };
+  }
+}
+
+async function saveSkillScore(user, params) {
+  try {
+    const { sessionId, skillData } = params;
+
+    // Get user's profile
+    const { data: profile } = await supabase
+      .from('profiles')
+      .select('id')
+      .eq('user_id', user.id)
+      .single();
+
+    if (!profile) {
+      return { status: 404, body: { error: 'User profile not found' } };
+    }
+
+    const result = await ScoreService.saveSkillScore(profile.id, sessionId, skillData);
+
+    if (!result.success) {
+      return { status: 400, body: { error: result.error } };
+    }
+
+    return {
+      status: 200,
+      body: {
+        success: true,
+        skillScore: result.skillScore,
+        newTotal: result.newTotal
+      }
+    };
+  } catch (error) {
+    console.error('Error saving skill score:', error);
+    return { status: 500, body: { error: 'Failed to save skill score' } };
+  }
+}
+
+// Adapts a shared route body to an Express handler
+function respondWith(handler) {
+  return async (req, res) => {
+    const { status, body } = await handler(req.user, req.body || {});
+    sendBody(req, res, status, body);
+  };
+}
+
+// Start a new game session
+router.post('/session/start', respondWith(startSession));
+
+// Save game progress during session
+router.post('/progress/save', respondWith(saveProgress));
+
+// End game session and save all scores
+router.post('/session/end', respondWith(endSession));
 
 // Get user's current stats (for loading into game)
 router.get('/stats', async (req, res) => {
@@ -233,103 +349,70 @@ router.get('/leaderboards/:type?', async (req, res) => {
 });
 
 // Save individual score types (additional endpoints if needed)
-router.post('/scores/normal', async (req, res) => {
-  try {
-    const userId = req.user.id;
-    const { sessionId, scoreData } = req.body;
-
-    // Get user's profile
-    const { data: profile } = await supabase
-      .from('profiles')
-      .select('id')
-      .eq('user_id', userId)
-      .single();
-
-    if (!profile) {
-      return res.status(404).json({ error: 'User profile not found' });
-    }
-
-    const result = await ScoreService.saveNormalScore(profile.id, sessionId, scoreData);
-
-    if (!result.success) {
-      return res.status(400).json({ error: result.error });
-    }
-
-    res.json({
-      success: true,
-      normalScore: result.normalScore,
-      isPersonalBest: result.isPersonalBest
+router.post('/scores/normal', respondWith(saveNormalScore));
+router.post('/scores/leaderboard', respondWith(saveLeaderboardScore));
+router.post('/scores/skill', respondWith(saveSkillScore));
+
+// Several of the routes above in one request. The client sends its
+// queued events together (gzip-compressed when large; the body parsers
+// inflate it) and gets one { status, body } per event, in order.
+// Events run in order, so a session_start may carry a client "ref" that
+// later events in the same batch use as "sessionRef" in place of the
+// session id they don't know yet.
+const BATCH_HANDLERS = {
+  session_start: startSession,
+  progress_save: saveProgress,
+  session_end: endSession,
+  score_normal: saveNormalScore,
+  score_leaderboard: saveLeaderboardScore,
+  score_skill: saveSkillScore
+};
+const MAX_BATCH_EVENTS = 100;
+
+router.post('/batch', async (req, res) => {
+  const { events } = req.body;
+
+  if (!Array.isArray(events) || events.length === 0) {
+    return res.status(400).json({
+      error: 'Events must be a non-empty array'
     });
-  } catch (error) {
-    console.error('Error saving normal score:', error);
-    res.status(500).json({ error: 'Failed to save normal score' });
   }
-});
-
-router.post('/scores/leaderboard', async (req, res) => {
-  try {
-    const userId = req.user.id;
-    const { sessionId, leaderboardData } = req.body;
-
-    // Get user's profile
-    const { data: profile } = await supabase
-      .from('profiles')
-      .select('id')
-      .eq('user_id', userId)
-      .single();
-
-    if (!profile) {
-      return res.status(404).json({ error: 'User profile not found' });
-    }
-
-    const result = await ScoreService.saveLeaderboardScore(profile.id, sessionId, leaderboardData);
-
-    if (!result.success) {
-      return res.status(400).json({ error: result.error });
-    }
-
-    res.json({
-      success: true,
-      leaderboardScore: result.leaderboardScore,
-      newTotal: result.newTotal
+  if (events.length > MAX_BATCH_EVENTS) {
+    return res.status(400).json({
+      error: `A batch holds at most ${MAX_BATCH_EVENTS} events`
     });
-  } catch (error) {
-    console.error('Error saving leaderboard score:', error);
-    res.status(500).json({ error: 'Failed to save leaderboard score' });
   }
-});
-
-router.post('/scores/skill', async (req, res) => {
-  try {
-    const userId = req.user.id;
-    const { sessionId, skillData } = req.body;
 
-    // Get user's profile
-    const { data: profile } = await supabase
-      .from('profiles')
-      .select('id')
-      .eq('user_id', userId)
-      .single();
-
-    if (!profile) {
-      return res.status(404).json({ error: 'User profile not found' });
+  const sessionRefs = new Map();
+  const results = [];
+  for (const event of events) {
+    const handler = event && BATCH_HANDLERS[event.type];
+    if (!handler) {
+      results.push({ status: 400, body: { error: `Unknown event type: ${event && event.type}` } });
+      continue;
     }
 
-    const result = await ScoreService.saveSkillScore(profile.id, sessionId, skillData);
-
-    if (!result.success) {
-      return res.status(400).json({ error: result.error });
+    const { type, ref, sessionRef, ...params } = event;
+    if (sessionRef !== undefined) {
+      if (!sessionRefs.has(sessionRef)) {
+        // The session_start it refers to failed or wasn't in this batch
+        results.push({ status: 424, body: { error: `Unknown session ref: ${sessionRef}` } });
+        continue;
+      }
+      params.sessionId = sessionRefs.get(sessionRef);
     }
 
-    res.json({
-      success: true,
-      skillScore: result.skillScore,
-      newTotal: result.newTotal
-    });
-  } catch (error) {
-    console.error('Error saving skill score:', error);
-    res.status(500).json({ error: 'Failed to save skill score' });
+    const result = await handler(req.user, params);
+    if (type === 'session_start' && ref !== undefined && result.status === 200) {
+      sessionRefs.set(ref, result.body.sessionId);
+    }
+    results.push(result);
   }
+
+  sendBody(req, res, 200, {
+    success: true,
+    results
+  });
 });
 
 module.exports = router; 
\ No newline at end of file
@@ -1,10 +1,20 @@
 const express = require('express');
 const GameSessionService = require('../services/GameSessionService');
+const userService = require('../services/userService');
 const { optionalAuth } = require('../middleware/auth');
 
 const router = express.Router();
 const gameSessionService = GameSessionService;
 
+// Accumulated points live in their own table, not on profiles
+async function getLeaderboardPoints(limit) {
+  const result = await gameSessionService.getLeaderboards('leaderboard', limit);
+  if (!result.success) {
+    throw new Error(result.error);
+  }
+  return result.data;
+}
+
 // @route   GET /api/leaderboard/scores
 // @desc    Get top game scores leaderboard (individual session scores)
 // @access  Public (with optional auth for user ranking)
@@ -13,7 +23,7 @@ router.get('/scores', optionalAuth, async (req, res, next) => {
     const limit = Math.min(parseInt(req.query.limit) || 50, 100);
     const timeframe = req.query.timeframe || 'all'; // all, daily, weekly, monthly
 
-    const leaderboard = await gameSessionService.getLeaderboard('score', limit, timeframe);
+    const leaderboard = await userService.getLeaderboard('score', limit, timeframe);
 
     res.json({
       success: true,
@@ -37,7 +47,7 @@ router.get('/leaderboard-points', optionalAuth, async (req, res, next) => {
   try {
     const limit = Math.min(parseInt(req.query.limit) || 50, 100);
 
-    const leaderboard = await gameSessionService.getLeaderboard('leaderboard_points', limit, 'all');
+    const leaderboard = await getLeaderboardPoints(limit);
 
     res.json({
       success: true,
@@ -62,7 +72,7 @@ router.get('/survival', optionalAuth, async (req, res, next) => {
     const limit = Math.min(parseInt(req.query.limit) || 50, 100);
     const timeframe = req.query.timeframe || 'all';
 
-    const leaderboard = await gameSessionService.getLeaderboard('survival', limit, timeframe);
+    const leaderboard = await userService.getLeaderboard('survival', limit, timeframe);
 
     res.json({
       success: true,
@@ -79,6 +89,30 @@ router.get('/survival', optionalAuth, async (req, res, next) => {
   }
 });
 
+// @route   GET /api/leaderboard/kills
+// @desc    Get most total kills leaderboard
+// @access  Public
+router.get('/kills', optionalAuth, async (req, res, next) => {
+  try {
+    const limit = Math.min(parseInt(req.query.limit) || 50, 100);
+
+    const leaderboard = await userService.getLeaderboard('kills', limit);
+
+    res.json({
+      success: true,
+      data: {
+        leaderboard,
+        type: 'Total Kills',
+        description: 'Most enemies defeated across all games',
+        timeframe: 'all',
+        totalEntries: leaderboard.length
+      }
+    });
+  } catch (error) {
+    next(error);
+  }
+});
+
 // @route   GET /api/leaderboard/all
 // @desc    Get all leaderboard types for dashboard display
 // @access  Public
@@ -88,9 +122,9 @@ router.get('/all', async (req, res, next) => {
 
     // Get top entries from each leaderboard type
     const [gameScores, leaderboardPoints, survivalTimes] = await Promise.all([
-      gameSessionService.getLeaderboard('score', limit, 'all'),
-      gameSessionService.getLeaderboard('leaderboard_points', limit, 'all'),
-      gameSessionService.getLeaderboard('survival', limit, 'all')
+      userService.getLeaderboard('score', limit, 'all'),
+      getLeaderboardPoints(limit),
+      userService.getLeaderboard('survival', limit, 'all')
     ]);
 
     res.json({
@@ -125,7 +159,7 @@ router.get('/recent', async (req, res, next) => {
   try {
     const limit = Math.min(parseInt(req.query.limit) || 20, 50);
 
-    const recentScores = await gameSessionService.getLeaderboard('score', limit, 'daily');
+    const recentScores = await userService.getLeaderboard('score', limit, 'daily');
 
     res.json({
       success: true,
@@ -17,6 +17,7 @@ const skillsRoutes = require('./routes/skills');
 // Import middleware
 const errorHandler = require('./middleware/errorHandler');
 const notFound = require('./middleware/notFound');
+const { parseBinaryBody } = require('./middleware/wireFormat');
 
 const app = express();
 
@@ -48,6 +49,7 @@ if (process.env.NODE_ENV !== 'test') {
 // Body parsing middleware
 app.use(express.json({ limit: '10mb' }));
 app.use(express.urlencoded({ extended: true, limit: '10mb' }));
+app.use(parseBinaryBody);
 
 // Health check endpoint
 app.get('/health', (req, res) => {
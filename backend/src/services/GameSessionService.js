@@ -5,7 +5,7 @@ class GameSessionService {
   constructor() {}
 
   // Start a new game session
-  async startSession(userId, gameMode = 'normal') {
+  async startSession(userId, gameMode = 'normal', seed = null) {
     try {
       // userId is actually the profile ID from the JWT token
       const profileId = userId;
@@ -32,6 +32,7 @@ class GameSessionService {
           score: 0,
           leaderboard_points_earned: 0,
           skill_points_earned: 0,
+          rng_seed: seed,
           started_at: new Date().toISOString()
         }])
         .select()
@@ -46,7 +47,8 @@ class GameSessionService {
       return {
         success: true,
         sessionId: session.id,
-        profileId: profile.id
+        profileId: profile.id,
+        seed: session.rng_seed
       };
     } catch (error) {
       console.error('Error starting session:', error);
@@ -0,0 +1,234 @@
+// CBOR (RFC 8949) for JSON-shaped values: null, booleans, numbers,
+// strings, arrays and plain objects. Byte strings decode to a Buffer;
+// tags and indefinite-length items are rejected.
+
+const MAJOR_UNSIGNED = 0;
+const MAJOR_NEGATIVE = 1;
+const MAJOR_BYTES = 2;
+const MAJOR_TEXT = 3;
+const MAJOR_ARRAY = 4;
+const MAJOR_MAP = 5;
+const MAJOR_SIMPLE = 7;
+
+class Writer {
+  constructor() {
+    this.buffer = Buffer.allocUnsafe(256);
+    this.length = 0;
+  }
+
+  reserve(size) {
+    if (this.length + size <= this.buffer.length) return;
+    const grown = Buffer.allocUnsafe(Math.max(this.buffer.length * 2, this.length + size));
+    this.buffer.copy(grown, 0, 0, this.length);
+    this.buffer = grown;
+  }
+
+  byte(value) {
+    this.reserve(1);
+    this.buffer[this.length++] = value;
+  }
+
+  // Initial byte plus the shortest argument that holds 'value'
+  head(major, value) {
+    const type = major << 5;
+    this.reserve(9);
+    if (value < 24) {
+      this.buffer[this.length++] = type | value;
+    } else if (value <= 0xff) {
+      this.buffer[this.length++] = type | 24;
+      this.buffer.writeUInt8(value, this.length);
+      this.length += 1;
+    } else if (value <= 0xffff) {
+      this.buffer[this.length++] = type | 25;
+      this.buffer.writeUInt16BE(value, this.length);
+      this.length += 2;
+    } else if (value <= 0xffffffff) {
+      this.buffer[this.length++] = type | 26;
+      this.buffer.writeUInt32BE(value, this.length);
+      this.length += 4;
+    } else {
+      this.buffer[this.length++] = type | 27;
+      this.buffer.writeBigUInt64BE(BigInt(value), this.length);
+      this.length += 8;
+    }
+  }
+
+  bytes(source) {
+    this.reserve(source.length);
+    source.copy(this.buffer, this.length);
+    this.length += source.length;
+  }
+
+  result() {
+    return this.buffer.subarray(0, this.length);
+  }
+}
+
+function encodeValue(writer, value) {
+  // Same values as JSON.stringify: toJSON() is honoured, undefined and
+  // functions are left out of objects, non-finite numbers become null
+  if (value !== null && typeof value === 'object' && typeof value.toJSON === 'function' &&
+      !Buffer.isBuffer(value)) {
+    value = value.toJSON();
+  }
+
+  switch (typeof value) {
+    case 'boolean':
+      return writer.byte(value ? 0xf5 : 0xf4);
+    case 'number':
+      if (!Number.isFinite(value)) return writer.byte(0xf6);
+      if (Number.isSafeInteger(value)) {
+        return value >= 0 ? writer.head(MAJOR_UNSIGNED, value) : writer.head(MAJOR_NEGATIVE, -1 - value);
+      }
+      writer.byte(0xfb);
+      writer.reserve(8);
+      writer.buffer.writeDoubleBE(value, writer.length);
+      writer.length += 8;
+      return;
+    case 'string': {
+      const bytes = Buffer.from(value, 'utf8');
+      writer.head(MAJOR_TEXT, bytes.length);
+      return writer.bytes(bytes);
+    }
+    case 'object':
+      break;
+    default:
+      return writer.byte(0xf6);
+  }
+
+  if (value === null) return writer.byte(0xf6);
+
+  if (Buffer.isBuffer(value)) {
+    writer.head(MAJOR_BYTES, value.length);
+    return writer.bytes(value);
+  }
+
+  if (Array.isArray(value)) {
+    writer.head(MAJOR_ARRAY, value.length);
+    for (const item of value) {
+      encodeValue(writer, item === undefined || typeof item === 'function' ? null : item);
+    }
+    return;
+  }
+
+  const keys = Object.keys(value).filter((key) => {
+    const item = value[key];
+    return item !== undefined && typeof item !== 'function' && typeof item !== 'symbol';
+  });
+  writer.head(MAJOR_MAP, keys.length);
+  for (const key of keys) {
+    encodeValue(writer, key);
+    encodeValue(writer, value[key]);
+  }
+}
+
+function encode(value) {
+  const writer = new Writer();
+  encodeValue(writer, value);
+  return writer.result();
+}
+
+// IEEE 754 half precision, which CBOR encoders use for short floats
+function decodeHalf(bits) {
+  const exponent = (bits >> 10) & 0x1f;
+  const fraction = bits & 0x3ff;
+  const sign = bits & 0x8000 ? -1 : 1;
+  if (exponent === 0) return sign * fraction * 2 ** -24;
+  if (exponent === 0x1f) return fraction ? NaN : sign * Infinity;
+  return sign * (1 + fraction / 1024) * 2 ** (exponent - 15);
+}
+
+class Reader {
+  constructor(buffer) {
+    this.buffer = buffer;
+    this.offset = 0;
+  }
+
+  take(size) {
+    if (this.offset + size > this.buffer.length) {
+      throw new RangeError('Unexpected end of CBOR data');
+    }
+    const start = this.offset;
+    this.offset += size;
+    return start;
+  }
+
+  argument(info) {
+    if (info < 24) return info;
+    switch (info) {
+      case 24: return this.buffer.readUInt8(this.take(1));
+      case 25: return this.buffer.readUInt16BE(this.take(2));
+      case 26: return this.buffer.readUInt32BE(this.take(4));
+      case 27: return Number(this.buffer.readBigUInt64BE(this.take(8)));
+      default:
+        throw new TypeError('Indefinite-length CBOR items are not supported');
+    }
+  }
+
+  map(length) {
+    const object = {};
+    for (let i = 0; i < length; i++) {
+      const key = String(this.value());
+      const item = this.value();
+      // As JSON.parse does, "__proto__" is an ordinary key
+      Object.defineProperty(object, key, { value: item, enumerable: true, writable: true, configurable: true });
+    }
+    return object;
+  }
+
+  value() {
+    const initial = this.buffer[this.take(1)];
+    const major = initial >> 5;
+    const info = initial & 0x1f;
+
+    if (major === MAJOR_SIMPLE) {
+      switch (info) {
+        case 20: return false;
+        case 21: return true;
+        case 22: return null;
+        case 23: return undefined;
+        case 25: return decodeHalf(this.buffer.readUInt16BE(this.take(2)));
+        case 26: return this.buffer.readFloatBE(this.take(4));
+        case 27: return this.buffer.readDoubleBE(this.take(8));
+        default:
+          throw new TypeError(`Unsupported CBOR simple value ${info}`);
+      }
+    }
+
+    const argument = this.argument(info);
+    switch (major) {
+      case MAJOR_UNSIGNED:
+        return argument;
+      case MAJOR_NEGATIVE:
+        return -1 - argument;
+      case MAJOR_BYTES: {
+        const at = this.take(argument);
+        return Buffer.from(this.buffer.subarray(at, at + argument));
+      }
+      case MAJOR_TEXT: {
+        const at = this.take(argument);
+        return this.buffer.toString('utf8', at, at + argument);
+      }
+      case MAJOR_ARRAY: {
+        const items = [];
+        for (let i = 0; i < argument; i++) items.push(this.value());
+        return items;
+      }
+      case MAJOR_MAP:
+        return this.map(argument);
+      default:
+        throw new TypeError('CBOR tags are not supported');
+    }
+  }
+}
+
+function decode(buffer) {
+  const reader = new Reader(buffer);
+  const value = reader.value();
+  if (reader.offset !== buffer.length) {
+    throw new RangeError('Trailing bytes after CBOR value');
+  }
+  return value;
+}
+
+module.exports = { encode, decode };
@@ -0,0 +1,242 @@
+// MessagePack (https://msgpack.org) for JSON-shaped values: null, booleans,
+// numbers, strings, arrays and plain objects. Binary data decodes to a
+// Buffer; extension types are rejected.
+
+class Writer {
+  constructor() {
+    this.buffer = Buffer.allocUnsafe(256);
+    this.length = 0;
+  }
+
+  reserve(size) {
+    if (this.length + size <= this.buffer.length) return;
+    const grown = Buffer.allocUnsafe(Math.max(this.buffer.length * 2, this.length + size));
+    this.buffer.copy(grown, 0, 0, this.length);
+    this.buffer = grown;
+  }
+
+  byte(value) {
+    this.reserve(1);
+    this.buffer[this.length++] = value;
+  }
+
+  // Type byte followed by a big-endian unsigned length or value
+  head(type, value, size) {
+    this.reserve(1 + size);
+    this.buffer[this.length++] = type;
+    if (size === 1) this.buffer.writeUInt8(value, this.length);
+    else if (size === 2) this.buffer.writeUInt16BE(value, this.length);
+    else if (size === 4) this.buffer.writeUInt32BE(value, this.length);
+    this.length += size;
+  }
+
+  bytes(source) {
+    this.reserve(source.length);
+    source.copy(this.buffer, this.length);
+    this.length += source.length;
+  }
+
+  result() {
+    return this.buffer.subarray(0, this.length);
+  }
+}
+
+function encodeInteger(writer, value) {
+  if (value >= 0) {
+    if (value < 0x80) return writer.byte(value);
+    if (value <= 0xff) return writer.head(0xcc, value, 1);
+    if (value <= 0xffff) return writer.head(0xcd, value, 2);
+    if (value <= 0xffffffff) return writer.head(0xce, value, 4);
+    writer.head(0xcf, 0, 0);
+    writer.reserve(8);
+    writer.buffer.writeBigUInt64BE(BigInt(value), writer.length);
+  } else {
+    if (value >= -32) return writer.byte(value & 0xff);
+    if (value >= -0x80) return writer.head(0xd0, value & 0xff, 1);
+    if (value >= -0x8000) return writer.head(0xd1, value & 0xffff, 2);
+    if (value >= -0x80000000) return writer.head(0xd2, value >>> 0, 4);
+    writer.head(0xd3, 0, 0);
+    writer.reserve(8);
+    writer.buffer.writeBigInt64BE(BigInt(value), writer.length);
+  }
+  writer.length += 8;
+}
+
+function encodeLength(writer, length, fixType, fixLimit, type16) {
+  if (length < fixLimit) return writer.byte(fixType | length);
+  if (length <= 0xffff) return writer.head(type16, length, 2);
+  writer.head(type16 + 1, length, 4);
+}
+
+function encodeValue(writer, value) {
+  // Same values as JSON.stringify: toJSON() is honoured, undefined and
+  // functions are left out of objects, non-finite numbers become null
+  if (value !== null && typeof value === 'object' && typeof value.toJSON === 'function' &&
+      !Buffer.isBuffer(value)) {
+    value = value.toJSON();
+  }
+
+  switch (typeof value) {
+    case 'boolean':
+      return writer.byte(value ? 0xc3 : 0xc2);
+    case 'number':
+      if (!Number.isFinite(value)) return writer.byte(0xc0);
+      if (Number.isSafeInteger(value)) return encodeInteger(writer, value);
+      writer.head(0xcb, 0, 0);
+      writer.reserve(8);
+      writer.buffer.writeDoubleBE(value, writer.length);
+      writer.length += 8;
+      return;
+    case 'string': {
+      const bytes = Buffer.from(value, 'utf8');
+      if (bytes.length < 32) writer.byte(0xa0 | bytes.length);
+      else if (bytes.length <= 0xff) writer.head(0xd9, bytes.length, 1);
+      else encodeLength(writer, bytes.length, 0, 0, 0xda);
+      return writer.bytes(bytes);
+    }
+    case 'object':
+      break;
+    default:
+      return writer.byte(0xc0);
+  }
+
+  if (value === null) return writer.byte(0xc0);
+
+  if (Buffer.isBuffer(value)) {
+    if (value.length <= 0xff) writer.head(0xc4, value.length, 1);
+    else if (value.length <= 0xffff) writer.head(0xc5, value.length, 2);
+    else writer.head(0xc6, value.length, 4);
+    return writer.bytes(value);
+  }
+
+  if (Array.isArray(value)) {
+    encodeLength(writer, value.length, 0x90, 16, 0xdc);
+    for (const item of value) {
+      encodeValue(writer, item === undefined || typeof item === 'function' ? null : item);
+    }
+    return;
+  }
+
+  const keys = Object.keys(value).filter((key) => {
+    const item = value[key];
+    return item !== undefined && typeof item !== 'function' && typeof item !== 'symbol';
+  });
+  encodeLength(writer, keys.length, 0x80, 16, 0xde);
+  for (const key of keys) {
+    encodeValue(writer, key);
+    encodeValue(writer, value[key]);
+  }
+}
+
+function encode(value) {
+  const writer = new Writer();
+  encodeValue(writer, value);
+  return writer.result();
+}
+
+class Reader {
+  constructor(buffer) {
+    this.buffer = buffer;
+    this.offset = 0;
+  }
+
+  take(size) {
+    if (this.offset + size > this.buffer.length) {
+      throw new RangeError('Unexpected end of MessagePack data');
+    }
+    const start = this.offset;
+    this.offset += size;
+    return start;
+  }
+
+  uint(size) {
+    const at = this.take(size);
+    if (size === 1) return this.buffer.readUInt8(at);
+    if (size === 2) return this.buffer.readUInt16BE(at);
+    if (size === 4) return this.buffer.readUInt32BE(at);
+    return Number(this.buffer.readBigUInt64BE(at));
+  }
+
+  int(size) {
+    const at = this.take(size);
+    if (size === 1) return this.buffer.readInt8(at);
+    if (size === 2) return this.buffer.readInt16BE(at);
+    if (size === 4) return this.buffer.readInt32BE(at);
+    return Number(this.buffer.readBigInt64BE(at));
+  }
+
+  string(length) {
+    const at = this.take(length);
+    return this.buffer.toString('utf8', at, at + length);
+  }
+
+  binary(length) {
+    const at = this.take(length);
+    return Buffer.from(this.buffer.subarray(at, at + length));
+  }
+
+  array(length) {
+    const items = [];
+    for (let i = 0; i < length; i++) items.push(this.value());
+    return items;
+  }
+
+  map(length) {
+    const object = {};
+    for (let i = 0; i < length; i++) {
+      const key = String(this.value());
+      const item = this.value();
+      // As JSON.parse does, "__proto__" is an ordinary key
+      Object.defineProperty(object, key, { value: item, enumerable: true, writable: true, configurable: true });
+    }
+    return object;
+  }
+
+  value() {
+    const type = this.buffer[this.take(1)];
+    if (type < 0x80) return type;
+    if (type < 0x90) return this.map(type & 0x0f);
+    if (type < 0xa0) return this.array(type & 0x0f);
+    if (type < 0xc0) return this.string(type & 0x1f);
+    if (type >= 0xe0) return type - 0x100;
+
+    switch (type) {
+      case 0xc0: return null;
+      case 0xc2: return false;
+      case 0xc3: return true;
+      case 0xc4: return this.binary(this.uint(1));
+      case 0xc5: return this.binary(this.uint(2));
+      case 0xc6: return this.binary(this.uint(4));
+      case 0xca: return this.buffer.readFloatBE(this.take(4));
+      case 0xcb: return this.buffer.readDoubleBE(this.take(8));
+      case 0xcc: return this.uint(1);
+      case 0xcd: return this.uint(2);
+      case 0xce: return this.uint(4);
+      case 0xcf: return this.uint(8);
+      case 0xd0: return this.int(1);
+      case 0xd1: return this.int(2);
+      case 0xd2: return this.int(4);
+      case 0xd3: return this.int(8);
+      case 0xd9: return this.string(this.uint(1));
+      case 0xda: return this.string(this.uint(2));
+      case 0xdb: return this.string(this.uint(4));
+      case 0xdc: return this.array(this.uint(2));
+      case 0xdd: return this.array(this.uint(4));
+      case 0xde: return this.map(this.uint(2));
+      case 0xdf: return this.map(this.uint(4));
+      default:
+        throw new TypeError(`Unsupported MessagePack type 0x${type.toString(16)}`);
+    }
+  }
+}
+
+function decode(buffer) {
+  const reader = new Reader(buffer);
+  const value = reader.value();
+  if (reader.offset !== buffer.length) {
+    throw new RangeError('Trailing bytes after MessagePack value');
+  }
+  return value;
+}
+
+module.exports = { encode, decode };
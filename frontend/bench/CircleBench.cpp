@@ -0,0 +1,65 @@
+#include "CircleMesh.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+
+// DrawCircle's vertex generation: the 32-segment cos/sin loop it replaced
+// against CircleMesh. Each iteration appends 1000 circles of the given
+// pixel radius to a reused batch, as a frame of cursor trail would.
+
+namespace {
+
+struct Vertex {
+    float x, y;
+    uint32_t color;
+};
+
+constexpr int kCirclesPerFrame = 1000;
+
+void AppendCircleTrig(std::vector<Vertex>& vertices, float x, float y, float radius, uint32_t color) {
+    const int segments = 32;
+    const float angleStep = 2.0f * static_cast<float>(M_PI) / segments;
+
+    float prevX = x + radius;
+    float prevY = y;
+    for (int i = 1; i <= segments; ++i) {
+        float angle = i * angleStep;
+        float nextX = x + cos(angle) * radius;
+        float nextY = y + sin(angle) * radius;
+        vertices.push_back({x, y, color});
+        vertices.push_back({prevX, prevY, color});
+        vertices.push_back({nextX, nextY, color});
+        prevX = nextX;
+        prevY = nextY;
+    }
+}
+
+void AppendCircleTable(std::vector<Vertex>& vertices, float x, float y, float radius, uint32_t color) {
+    const int segments = CircleMesh::SegmentsForRadius(radius);
+    size_t base = vertices.size();
+    vertices.resize(base + segments * 3);
+    CircleMesh::WriteTriangles(vertices.data() + base, segments, x, y, radius, color);
+}
+
+template <void (*Append)(std::vector<Vertex>&, float, float, float, uint32_t)>
+void BM_DrawCircle(benchmark::State& state) {
+    const float radius = static_cast<float>(state.range(0));
+    std::vector<Vertex> vertices;
+    vertices.reserve(kCirclesPerFrame * CircleMesh::kMaxSegments * 3);
+
+    for (auto _ : state) {
+        vertices.clear();
+        for (int i = 0; i < kCirclesPerFrame; ++i) {
+            Append(vertices, static_cast<float>(i), static_cast<float>(i & 63), radius, 0xffffffffu);
+        }
+        benchmark::DoNotOptimize(vertices.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kCirclesPerFrame);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_DrawCircle, AppendCircleTrig)->Arg(3)->Arg(10)->Arg(25)->Arg(60);
+BENCHMARK_TEMPLATE(BM_DrawCircle, AppendCircleTable)->Arg(3)->Arg(10)->Arg(25)->Arg(60);
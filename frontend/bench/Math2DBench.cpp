@@ -0,0 +1,167 @@
+#include "Math2D.h"
+#include "MovementKernels.h"
+#include "Random.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+// Per-enemy math in its sqrt-free forms. Steering: a per-enemy sqrt and
+// divide against every IntegrateSteering kernel this CPU can run (scalar,
+// SSE2, AVX2), which normalize with rsqrt plus a Newton-Raphson step.
+// Collision: comparing the sqrt distance against Math2D::CirclesOverlap,
+// every enemy tested against the player.
+
+namespace {
+
+std::vector<Vec2> MakeOffsets(size_t count) {
+    Random random(99, 0);
+    std::vector<Vec2> offsets(count);
+    for (Vec2& offset : offsets) {
+        offset = Vec2(random.Range(-800.0f, 800.0f), random.Range(-600.0f, 600.0f));
+    }
+    return offsets;
+}
+
+// Enemy columns as the ECS stores them: interleaved x, y floats
+struct Enemies {
+    std::vector<float> position;
+    std::vector<float> previousPosition;
+    std::vector<float> velocity;
+    std::vector<float> acceleration;
+    std::vector<uint8_t> culled;
+
+    explicit Enemies(size_t count)
+        : previousPosition(count * 2), velocity(count * 2, 0.0f), acceleration(count), culled(count) {
+        for (const Vec2& offset : MakeOffsets(count)) {
+            position.push_back(offset.x);
+            position.push_back(offset.y);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            acceleration[i] = 120.0f + static_cast<float>(i % 7) * 10.0f;
+        }
+    }
+
+    SteeringBatch Batch() {
+        SteeringBatch batch;
+        batch.position = position.data();
+        batch.previousPosition = previousPosition.data();
+        batch.velocity = velocity.data();
+        batch.acceleration = acceleration.data();
+        batch.culled = culled.data();
+        batch.count = acceleration.size();
+        batch.targetX = 3.0f;
+        batch.targetY = -2.0f;
+        batch.deltaTime = 1.0f / 60.0f;
+        batch.minX = -1000.0f;
+        batch.minY = -1000.0f;
+        batch.maxX = 1000.0f;
+        batch.maxY = 1000.0f;
+        return batch;
+    }
+};
+
+// Same steps as the kernels, normalizing with sqrt and a divide
+void IntegrateSqrtDivide(const SteeringBatch& b) {
+    for (size_t i = 0; i < b.count; ++i) {
+        float x = b.position[i * 2];
+        float y = b.position[i * 2 + 1];
+        float dx = b.targetX - x;
+        float dy = b.targetY - y;
+        float length = std::sqrt(dx * dx + dy * dy);
+        if (length > 0.0f) {
+            dx /= length;
+            dy /= length;
+        }
+        float vx = b.velocity[i * 2] + dx * b.acceleration[i] * b.deltaTime;
+        float vy = b.velocity[i * 2 + 1] + dy * b.acceleration[i] * b.deltaTime;
+        b.velocity[i * 2] = vx;
+        b.velocity[i * 2 + 1] = vy;
+
+        b.previousPosition[i * 2] = x;
+        b.previousPosition[i * 2 + 1] = y;
+        x += vx * b.deltaTime;
+        y += vy * b.deltaTime;
+        b.position[i * 2] = x;
+        b.position[i * 2 + 1] = y;
+
+        b.culled[i] = (x < b.minX) | (x > b.maxX) | (y < b.minY) | (y > b.maxY);
+    }
+}
+
+// One step from the same start must land where the sqrt version does
+bool MatchesSqrtDivide(void (*integrate)(const SteeringBatch&), size_t count) {
+    Enemies expected(count);
+    Enemies actual(count);
+    IntegrateSqrtDivide(expected.Batch());
+    integrate(actual.Batch());
+    for (size_t i = 0; i < count * 2; ++i) {
+        if (std::fabs(expected.velocity[i] - actual.velocity[i]) > 1e-3f ||
+            std::fabs(expected.position[i] - actual.position[i]) > 1e-3f) {
+            return false;
+        }
+    }
+    return expected.culled == actual.culled;
+}
+
+void BM_Steering(benchmark::State& state, void (*integrate)(const SteeringBatch&)) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    if (!MatchesSqrtDivide(integrate, count)) {
+        state.SkipWithError("kernel disagrees with sqrt + divide");
+        return;
+    }
+    Enemies enemies(count);
+    const SteeringBatch batch = enemies.Batch();
+    for (auto _ : state) {
+        integrate(batch);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+const bool kSteeringRegistered = [] {
+    benchmark::RegisterBenchmark("BM_Steering/sqrt+divide", BM_Steering, IntegrateSqrtDivide)
+        ->Arg(10000)->Arg(100000);
+    for (const SteeringKernelInfo& kernel : GetSteeringKernels()) {
+        std::string name = std::string("BM_Steering/") + kernel.name;
+        benchmark::RegisterBenchmark(name.c_str(), BM_Steering, kernel.integrate)->Arg(10000)->Arg(100000);
+    }
+    return true;
+}();
+
+void BM_CollideSqrtDistance(benchmark::State& state) {
+    std::vector<Vec2> positions = MakeOffsets(static_cast<size_t>(state.range(0)));
+    const Vec2 player(0.0f, 0.0f);
+    for (auto _ : state) {
+        int hits = 0;
+        for (const Vec2& position : positions) {
+            Vec2 d = position - player;
+            if (std::sqrt(d.LengthSquared()) < 8.0f + 12.0f) {
+                ++hits;
+            }
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_CollideSquaredDistance(benchmark::State& state) {
+    std::vector<Vec2> positions = MakeOffsets(static_cast<size_t>(state.range(0)));
+    const Vec2 player(0.0f, 0.0f);
+    for (auto _ : state) {
+        int hits = 0;
+        for (const Vec2& position : positions) {
+            if (Math2D::CirclesOverlap(player, 8.0f, position, 12.0f)) {
+                ++hits;
+            }
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_CollideSqrtDistance)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_CollideSquaredDistance)->Arg(10000)->Arg(100000);
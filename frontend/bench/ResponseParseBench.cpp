@@ -0,0 +1,203 @@
+#include "NetworkManager.h"
+#include "HomeState.h"
+#include "AllocationCounter.h"
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+// NetworkManager's streaming leaderboard and skills parsers against
+// json::parse followed by copying into the structs ("DOM"). Payloads have
+// the shapes of GET /api/leaderboard/scores and GET /api/skills/user. The
+// "allocs" counter is heap allocations per parse.
+
+using json = nlohmann::json;
+
+namespace {
+
+std::string MakeLeaderboard(int rows) {
+    json leaderboard = json::array();
+    for (int i = 0; i < rows; ++i) {
+        leaderboard.push_back({
+            {"rank", i + 1},
+            {"userId", "6d1f0c2a-4b7e-4f3a-9c85-" + std::to_string(100000000000 + i)},
+            {"username", "player_" + std::to_string(i)},
+            {"level", 1 + i % 50},
+            {"avatar", "https://cdn.example.com/avatars/" + std::to_string(i) + ".png"},
+            {"score", 250000 - i * 211},
+            {"survivalTime", 900 - i % 600},
+            {"kills", 4000 - i * 3},
+            {"achievedAt", "2026-10-01T12:34:56.789Z"}
+        });
+    }
+    json body;
+    body["success"] = true;
+    body["data"] = {
+        {"leaderboard", leaderboard},
+        {"type", "Game Scores"},
+        {"description", "Highest individual game session scores"},
+        {"timeframe", "all"},
+        {"totalEntries", rows}
+    };
+    return body.dump();
+}
+
+std::string MakeSkills(int count) {
+    json skills = json::array();
+    for (int i = 0; i < count; ++i) {
+        json effects = json::array();
+        for (int e = 0; e < 3; ++e) {
+            effects.push_back({
+                {"type", e == 0 ? "damage_multiplier" : e == 1 ? "cooldown_reduction" : "max_health"},
+                {"currentValue", 0.05 * e + 0.1},
+                {"nextValue", 0.05 * e + 0.15},
+                {"isPercentage", e != 2}
+            });
+        }
+        skills.push_back({
+            {"skillId", "skill_" + std::to_string(i)},
+            {"name", "Skill number " + std::to_string(i)},
+            {"description", "Improves an aspect of the cursor's survival by a small amount per level"},
+            {"category", i % 2 ? "offense" : "defense"},
+            {"icon", "icons/skill_" + std::to_string(i) + ".png"},
+            {"maxLevel", 10},
+            {"currentLevel", i % 10},
+            {"isUnlocked", i % 3 != 0},
+            {"prerequisitesMet", true},
+            {"canUpgrade", i % 4 != 0},
+            {"nextLevelCost", 1 + i % 5},
+            {"effects", effects},
+            {"prerequisites", json::array({{{"skillId", "skill_0"}, {"level", 1}}})},
+            {"unlockLevel", i % 20},
+            {"isMaxLevel", false}
+        });
+    }
+    json body;
+    body["success"] = true;
+    body["data"] = {
+        {"skills", skills},
+        {"currency", {{"skillPoints", 42}, {"coins", 1337}}},
+        {"userLevel", 17}
+    };
+    return body.dump();
+}
+
+bool ParseLeaderboardDom(const std::string& data, std::vector<LeaderboardEntry>& entries) {
+    json root = json::parse(data, nullptr, false);
+    if (root.is_discarded() || !root.contains("data")) return false;
+    entries.clear();
+    for (const json& row : root["data"]["leaderboard"]) {
+        LeaderboardEntry entry;
+        entry.rank = row.value("rank", 0);
+        entry.username = row.value("username", "");
+        entry.level = row.value("level", 0);
+        entry.avatar = row.value("avatar", "");
+        entry.score = row.value("score", 0);
+        entry.survivalTime = row.value("survivalTime", 0);
+        entry.kills = row.value("kills", 0);
+        entry.achievedAt = row.value("achievedAt", "");
+        entries.push_back(std::move(entry));
+    }
+    return true;
+}
+
+bool ParseSkillsDom(const std::string& data, std::vector<Skill>& skills, UserCurrency& currency, int& userLevel) {
+    json root = json::parse(data, nullptr, false);
+    if (root.is_discarded() || !root.contains("data")) return false;
+    const json& body = root["data"];
+    skills.clear();
+    for (const json& item : body["skills"]) {
+        Skill skill;
+        skill.skillId = item.value("skillId", "");
+        skill.name = item.value("name", "");
+        skill.description = item.value("description", "");
+        skill.category = item.value("category", "");
+        skill.icon = item.value("icon", "");
+        skill.maxLevel = item.value("maxLevel", 0);
+        skill.currentLevel = item.value("currentLevel", 0);
+        skill.isUnlocked = item.value("isUnlocked", false);
+        skill.prerequisitesMet = item.value("prerequisitesMet", false);
+        skill.canUpgrade = item.value("canUpgrade", false);
+        skill.nextLevelCost = item.value("nextLevelCost", 0);
+        skill.unlockLevel = item.value("unlockLevel", 0);
+        for (const json& e : item["effects"]) {
+            skill.effects.push_back({e.value("type", ""), e.value("currentValue", 0.0f),
+                                     e.value("nextValue", 0.0f), e.value("isPercentage", false)});
+        }
+        skills.push_back(std::move(skill));
+    }
+    currency.skillPoints = body["currency"].value("skillPoints", 0);
+    currency.coins = body["currency"].value("coins", 0);
+    userLevel = body.value("userLevel", 0);
+    return true;
+}
+
+enum Mode { Dom, SaxNewVector, SaxReused };
+
+void SetAllocationCounter(benchmark::State& state, const AllocationCounter::Scope& scope) {
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(scope.count.load()),
+                                                  benchmark::Counter::kAvgIterations);
+}
+
+void BM_Leaderboard(benchmark::State& state) {
+    const std::string data = MakeLeaderboard(static_cast<int>(state.range(0)));
+    const Mode mode = static_cast<Mode>(state.range(1));
+    std::vector<LeaderboardEntry> reused;
+    NetworkManager::ParseLeaderboardResponse(data, reused);
+
+    AllocationCounter::Scope scope;
+    AllocationCounter::Scope* previous = AllocationCounter::SetCurrentScope(&scope);
+    for (auto _ : state) {
+        bool parsed;
+        if (mode == Dom) {
+            std::vector<LeaderboardEntry> entries;
+            parsed = ParseLeaderboardDom(data, entries);
+        } else if (mode == SaxNewVector) {
+            std::vector<LeaderboardEntry> entries;
+            parsed = NetworkManager::ParseLeaderboardResponse(data, entries);
+        } else {
+            parsed = NetworkManager::ParseLeaderboardResponse(data, reused);
+        }
+        if (!parsed) {
+            state.SkipWithError("parse failed");
+            break;
+        }
+    }
+    AllocationCounter::SetCurrentScope(previous);
+    SetAllocationCounter(state, scope);
+}
+
+void BM_Skills(benchmark::State& state) {
+    const std::string data = MakeSkills(static_cast<int>(state.range(0)));
+    const Mode mode = static_cast<Mode>(state.range(1));
+    std::vector<Skill> reused;
+    UserCurrency currency{};
+    int userLevel = 0;
+    NetworkManager::ParseSkillsResponse(data, reused, currency, userLevel);
+
+    AllocationCounter::Scope scope;
+    AllocationCounter::Scope* previous = AllocationCounter::SetCurrentScope(&scope);
+    for (auto _ : state) {
+        bool parsed;
+        if (mode == Dom) {
+            std::vector<Skill> skills;
+            parsed = ParseSkillsDom(data, skills, currency, userLevel);
+        } else if (mode == SaxNewVector) {
+            std::vector<Skill> skills;
+            parsed = NetworkManager::ParseSkillsResponse(data, skills, currency, userLevel);
+        } else {
+            parsed = NetworkManager::ParseSkillsResponse(data, reused, currency, userLevel);
+        }
+        if (!parsed) {
+            state.SkipWithError("parse failed");
+            break;
+        }
+    }
+    AllocationCounter::SetCurrentScope(previous);
+    SetAllocationCounter(state, scope);
+}
+
+} // namespace
+
+BENCHMARK(BM_Leaderboard)->ArgNames({"rows", "mode"})->ArgsProduct({{100, 1000}, {Dom, SaxNewVector, SaxReused}});
+BENCHMARK(BM_Skills)->ArgNames({"skills", "mode"})->ArgsProduct({{40}, {Dom, SaxNewVector, SaxReused}});
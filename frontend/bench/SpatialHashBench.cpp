@@ -0,0 +1,106 @@
+#include "SpatialHash.h"
+#include "Random.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <cmath>
+
+// SpatialHash at a constant density of one entity per two 64-unit cells,
+// so the world grows with the entity count. Queries use the player's
+// radius; "brute force" is the linear scan CheckCollisions used to do.
+
+namespace {
+
+constexpr float kCellSize = 64.0f;
+constexpr float kEntityRadius = 8.0f;
+constexpr float kQueryRadius = 8.0f;
+constexpr float kNearestRange = 128.0f;
+
+struct World {
+    std::vector<Vec2> positions;
+    std::vector<Vec2> queries;
+    SpatialHash grid{kCellSize};
+
+    explicit World(size_t count) {
+        // Side length giving two cells per entity
+        float side = std::sqrt(static_cast<float>(count) * 2.0f) * kCellSize;
+        Random random(1234, 0);
+        positions.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            positions.emplace_back(random.Range(0.0f, side), random.Range(0.0f, side));
+        }
+        for (int i = 0; i < 1024; ++i) {
+            queries.emplace_back(random.Range(0.0f, side), random.Range(0.0f, side));
+        }
+        Rebuild();
+    }
+
+    void Rebuild() {
+        grid.Clear();
+        grid.Reserve(positions.size());
+        for (size_t i = 0; i < positions.size(); ++i) {
+            grid.Insert(static_cast<int>(i), positions[i].x, positions[i].y, kEntityRadius);
+        }
+        grid.Build();
+    }
+};
+
+void BM_Build(benchmark::State& state) {
+    World world(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        world.Rebuild();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_QueryCircle(benchmark::State& state) {
+    World world(static_cast<size_t>(state.range(0)));
+    size_t q = 0;
+    for (auto _ : state) {
+        const Vec2& center = world.queries[q++ & 1023];
+        int hits = 0;
+        world.grid.QueryCircle(center.x, center.y, kQueryRadius, [&](int) { ++hits; });
+        benchmark::DoNotOptimize(hits);
+    }
+}
+
+void BM_QueryBruteForce(benchmark::State& state) {
+    World world(static_cast<size_t>(state.range(0)));
+    size_t q = 0;
+    for (auto _ : state) {
+        const Vec2& center = world.queries[q++ & 1023];
+        int hits = 0;
+        for (const Vec2& position : world.positions) {
+            if (Math2D::CirclesOverlap(center, kQueryRadius, position, kEntityRadius)) {
+                ++hits;
+            }
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+}
+
+void BM_FindNearest(benchmark::State& state) {
+    World world(static_cast<size_t>(state.range(0)));
+    size_t q = 0;
+    for (auto _ : state) {
+        const Vec2& center = world.queries[q++ & 1023];
+        benchmark::DoNotOptimize(world.grid.FindNearest(center.x, center.y, kNearestRange));
+    }
+}
+
+void BM_ForEachPair(benchmark::State& state) {
+    World world(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        int pairs = 0;
+        world.grid.ForEachPair([&](int, int) { ++pairs; });
+        benchmark::DoNotOptimize(pairs);
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_Build)->RangeMultiplier(10)->Range(100, 100000);
+BENCHMARK(BM_QueryCircle)->RangeMultiplier(10)->Range(100, 100000);
+BENCHMARK(BM_QueryBruteForce)->RangeMultiplier(10)->Range(100, 100000);
+BENCHMARK(BM_FindNearest)->RangeMultiplier(10)->Range(100, 100000);
+BENCHMARK(BM_ForEachPair)->RangeMultiplier(10)->Range(100, 100000);
@@ -0,0 +1,125 @@
+#include "WireFormat.h"
+#include "NetworkManager.h"
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <string>
+
+// Telemetry bodies in each wire format, shaped like the ones
+// AuthNetworkManager sends: a progress save, a session end, and a batch of
+// 16 of each. Counters report the encoded and gzipped sizes.
+
+using json = nlohmann::json;
+
+namespace {
+
+enum Payload { Progress, End, Batch32 };
+
+json MakeProgress(int i) {
+    json event;
+    event["sessionId"] = "3f2c9a4e-8b1d-4c6f-9e2a-7d5b1c0e" + std::to_string(1000 + i);
+    event["sessionRef"] = "a1b2c3d4e5f60718";
+    event["currentScore"] = 15230 + i * 37;
+    event["leaderboardPoints"] = 152 + i;
+    event["skillPoints"] = 12;
+    event["survivalTime"] = 184.25 + i;
+    event["livesRemaining"] = 2;
+    return event;
+}
+
+json MakeEnd(int i) {
+    json event;
+    event["sessionId"] = "3f2c9a4e-8b1d-4c6f-9e2a-7d5b1c0e" + std::to_string(1000 + i);
+    event["sessionRef"] = "a1b2c3d4e5f60718";
+    event["finalScore"] = 48210 + i * 91;
+    event["leaderboardPointsEarned"] = 482 + i;
+    event["skillPointsEarned"] = 31;
+    event["survivalTime"] = 612.5 + i;
+    event["kills"] = 1843 + i;
+    event["damageDealt"] = 98231.75;
+    event["damageTaken"] = 412.0;
+    event["waveReached"] = 14;
+    event["endReason"] = "player_death";
+    return event;
+}
+
+json MakePayload(Payload payload) {
+    switch (payload) {
+        case Progress:
+            return MakeProgress(0);
+        case End:
+            return MakeEnd(0);
+        case Batch32:
+            break;
+    }
+    json body;
+    json& events = body["events"];
+    events = json::array();
+    for (int i = 0; i < 16; ++i) {
+        json progress = MakeProgress(i);
+        progress["type"] = "progress_save";
+        events.push_back(std::move(progress));
+        json end = MakeEnd(i);
+        end["type"] = "session_end";
+        events.push_back(std::move(end));
+    }
+    return body;
+}
+
+void SetSizeCounters(benchmark::State& state, const std::string& encoded) {
+    std::string compressed;
+    GzipCompress(encoded, compressed);
+    state.counters["bytes"] = static_cast<double>(encoded.size());
+    state.counters["gzipped"] = static_cast<double>(compressed.size());
+}
+
+void BM_Encode(benchmark::State& state) {
+    const json body = MakePayload(static_cast<Payload>(state.range(0)));
+    const WireFormat format = static_cast<WireFormat>(state.range(1));
+    std::string encoded;
+    for (auto _ : state) {
+        encoded = EncodeBody(body, format);
+        benchmark::DoNotOptimize(encoded.data());
+    }
+    SetSizeCounters(state, encoded);
+}
+
+void BM_Decode(benchmark::State& state) {
+    const WireFormat format = static_cast<WireFormat>(state.range(1));
+    HttpResponse response;
+    response.success = true;
+    response.statusCode = 200;
+    response.data = EncodeBody(MakePayload(static_cast<Payload>(state.range(0))), format);
+    response.contentType = GetContentType(format);
+    for (auto _ : state) {
+        json body;
+        if (!DecodeBody(response, body)) {
+            state.SkipWithError("DecodeBody failed");
+            break;
+        }
+        benchmark::DoNotOptimize(body);
+    }
+}
+
+void BM_Gzip(benchmark::State& state) {
+    const std::string encoded = EncodeBody(MakePayload(Batch32), static_cast<WireFormat>(state.range(0)));
+    std::string compressed;
+    for (auto _ : state) {
+        GzipCompress(encoded, compressed);
+        benchmark::DoNotOptimize(compressed.data());
+    }
+}
+
+void FormatArgs(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"payload", "format"});
+    for (int payload : {Progress, End, Batch32}) {
+        for (WireFormat format : {WireFormat::Json, WireFormat::MessagePack, WireFormat::Cbor}) {
+            bench->Args({payload, static_cast<int>(format)});
+        }
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_Encode)->Apply(FormatArgs);
+BENCHMARK(BM_Decode)->Apply(FormatArgs);
+BENCHMARK(BM_Gzip)->ArgName("format")->DenseRange(0, 2);
@@ -0,0 +1,119 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace {
+std::atomic<uint64_t> g_allocationCount{0};
+std::atomic<uint64_t> g_allocatedBytes{0};
+thread_local AllocationCounter::Scope* t_scope = nullptr;
+
+void Count(std::size_t size) {
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (t_scope) {
+        t_scope->count.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void* Allocate(std::size_t size) {
+    Count(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* AllocateAligned(std::size_t size, std::size_t alignment) {
+    Count(size);
+    if (alignment < sizeof(void*)) {
+        alignment = sizeof(void*);
+    }
+#if defined(_WIN32)
+    return _aligned_malloc(size ? size : 1, alignment);
+#else
+    void* pointer = nullptr;
+    if (posix_memalign(&pointer, alignment, size ? size : 1) != 0) {
+        return nullptr;
+    }
+    return pointer;
+#endif
+}
+
+// _aligned_malloc memory can't go to free()
+void FreeAligned(void* pointer) {
+#if defined(_WIN32)
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+}
+
+namespace AllocationCounter {
+
+uint64_t GetAllocationCount() {
+    return g_allocationCount.load(std::memory_order_relaxed);
+}
+
+uint64_t GetAllocatedBytes() {
+    return g_allocatedBytes.load(std::memory_order_relaxed);
+}
+
+Scope* SetCurrentScope(Scope* scope) {
+    Scope* previous = t_scope;
+    t_scope = scope;
+    return previous;
+}
+
+Scope* GetCurrentScope() {
+    return t_scope;
+}
+
+}
+
+// Replacement global allocation functions
+
+void* operator new(std::size_t size) {
+    void* pointer = Allocate(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    void* pointer = Allocate(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return Allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return Allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    void* pointer = AllocateAligned(size, static_cast<std::size_t>(alignment));
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    void* pointer = AllocateAligned(size, static_cast<std::size_t>(alignment));
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { FreeAligned(pointer); }
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Process-wide heap allocation counters, fed by the replacement global
+// operator new/delete in AllocationCounter.cpp. Only allocations that go
+// through operator new are seen; libraries calling malloc directly (SDL,
+// ImGui) are not. Counters are relaxed atomics shared by every thread.
+namespace AllocationCounter {
+
+// Allocations since startup
+uint64_t GetAllocationCount();
+uint64_t GetAllocatedBytes();
+
+// Counts the allocations of one piece of work, whichever threads run it:
+// a thread counts into its current scope, and JobSystem gives each job
+// the scope of the thread that submitted it
+struct Scope {
+    std::atomic<uint64_t> count{0};
+};
+
+// Returns the scope it replaces; pass that back to restore it
+Scope* SetCurrentScope(Scope* scope);
+Scope* GetCurrentScope();
+
+}
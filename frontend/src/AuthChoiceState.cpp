@@ -4,6 +4,7 @@
 #include "Renderer.h"
 #include "NetworkManager.h"
 #include "AuthNetworkManager.h"
+#include "SessionJournal.h"
 #include <SDL2/SDL.h>
 #include <imgui.h>
 #include <iostream>
@@ -20,9 +21,16 @@ AuthChoiceState::AuthChoiceState(Game* game)
     , m_showLinkedForm(false)
     , m_isLoading(false)
     , m_authSuccessful(false)
-    , m_networkManager(std::make_unique<NetworkManager>())
-    , m_authNetworkManager(std::make_unique<AuthNetworkManager>())
+    , m_networkManager(std::make_unique<NetworkManager>(game->GetHttpClient()))
+    , m_authNetworkManager(std::make_unique<AuthNetworkManager>(game->GetHttpClient()))
 {
+    // Server address and timeout from the config
+    const GameConfig& config = m_game->GetConfig();
+    m_networkManager->SetBaseUrl(config.network.apiBaseUrl);
+    m_networkManager->SetTimeout(config.network.timeoutMs);
+    m_authNetworkManager->SetBaseUrl(config.network.apiBaseUrl);
+    m_authNetworkManager->SetTimeout(config.network.timeoutMs);
+    
     // Initialize Steam if available
     InitializeSteam();
 }
@@ -72,8 +80,9 @@ void AuthChoiceState::OnEnter() {
                     
                     std::string token = responseData["data"]["token"].get<std::string>();
                     std::string username = responseData["data"]["user"]["username"].get<std::string>();
+                    std::string userId = responseData["data"]["user"].value("id", "");
                     
-                    OnAuthSuccess(token, "Development authentication successful!");
+                    OnAuthSuccess(token, userId, "Development authentication successful!");
                 } else {
                     OnAuthError("Failed to parse development authentication response");
                 }
@@ -102,11 +111,6 @@ void AuthChoiceState::HandleEvent(const SDL_Event& event) {
 }
 
 void AuthChoiceState::Update(float deltaTime) {
-    // Update network manager to process async requests
-    if (m_authNetworkManager) {
-        m_authNetworkManager->Update();
-    }
-    
     // Check if authentication was successful and transition to home state
     if (m_authSuccessful) {
         m_authSuccessful = false; // Reset flag
@@ -283,8 +287,8 @@ void AuthChoiceState::RenderMethodChoice() {
     ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.1f, 0.5f, 0.1f, 1.0f));
     
     if (ImGui::Button("🚀 Play Without Account (Test Mode)", ImVec2(400, 30))) {
-        // Use a test token for development
-        OnAuthSuccess("test_token_for_development_" + std::to_string(time(nullptr)), "Test user");
+        // Use a test token for development; there's no account to record sessions for
+        OnAuthSuccess("test_token_for_development_" + std::to_string(time(nullptr)), "", "Test user");
     }
     
     ImGui::PopStyleColor(3);
@@ -637,14 +641,14 @@ void AuthChoiceState::OnSteamAuth() {
     m_authNetworkManager->LoginSteamUser(m_steamId, [this](const AuthResponse& response) {
         if (response.success) {
             // Existing Steam user
-            OnAuthSuccess(response.token, "Steam login successful!");
+            OnAuthSuccess(response.token, response.userId, "Steam login successful!");
         } else {
             // New Steam user, create account
             m_authNetworkManager->CreateSteamUser(m_steamId, m_steamUsername, m_steamAvatar, [this](const AuthResponse& createResponse) {
                 m_isLoading = false;
                 
                 if (createResponse.success) {
-                    OnAuthSuccess(createResponse.token, "Steam account created successfully!");
+                    OnAuthSuccess(createResponse.token, createResponse.userId, "Steam account created successfully!");
                 } else {
                     OnAuthError(createResponse.error);
                 }
@@ -697,7 +701,7 @@ void AuthChoiceState::OnLinkedRegister() {
             m_isLoading = false;
             
             if (response.success) {
-                OnAuthSuccess(response.token, "Linked account created successfully!");
+                OnAuthSuccess(response.token, response.userId, "Linked account created successfully!");
             } else {
                 OnAuthError(response.error);
             }
@@ -750,7 +754,7 @@ bool AuthChoiceState::ValidateLinkedForm() {
 }
 
 // Network callbacks
-void AuthChoiceState::OnAuthSuccess(const std::string& token, const std::string& userData) {
+void AuthChoiceState::OnAuthSuccess(const std::string& token, const std::string& userId, const std::string& userData) {
     m_isLoading = false;
     m_statusMessage = "Success! Logging in...";
     
@@ -758,6 +762,9 @@ void AuthChoiceState::OnAuthSuccess(const std::string& token, const std::string&
     m_authToken = token;
     std::cout << "Authentication successful! Token received." << std::endl;
     
+    // Sessions are journaled under this user and uploaded with this token
+    m_game->GetSessionJournal()->SetUser(userId, token);
+    
     // TODO: Parse user data
     
     // Set flag to transition to main game on next update (thread-safe)
@@ -886,7 +893,7 @@ void AuthChoiceState::OnEmailLogin() {
         m_isLoading = false;
         
         if (response.success) {
-            OnAuthSuccess(response.token, "Login successful!");
+            OnAuthSuccess(response.token, response.userId, "Login successful!");
         } else {
             OnAuthError(response.error);
         }
@@ -927,7 +934,7 @@ void AuthChoiceState::OnEmailCheckResult(bool exists, const std::string& error)
         m_isLoading = false;
         
         if (response.success) {
-            OnAuthSuccess(response.token, "Email account created successfully!");
+            OnAuthSuccess(response.token, response.userId, "Email account created successfully!");
         } else {
             OnAuthError(response.error);
         }
@@ -85,7 +85,7 @@ private:
     bool ValidateLinkedForm();
     
     // Network callbacks
-    void OnAuthSuccess(const std::string& token, const std::string& userData);
+    void OnAuthSuccess(const std::string& token, const std::string& userId, const std::string& userData);
     void OnAuthError(const std::string& error);
     
     // Steam integration (placeholder for actual Steam API)
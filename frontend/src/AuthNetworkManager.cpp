@@ -1,55 +1,69 @@
 #include "AuthNetworkManager.h"
-#include <curl/curl.h>
+#include "HttpClient.h"
 #include <nlohmann/json.hpp>
-#include <thread>
-#include <queue>
-#include <mutex>
 #include <iostream>
 #include <sstream>
+#include <chrono>
+#include <vector>
+#include <cstdio>
 
 using json = nlohmann::json;
 
-// Structure for write callback
-struct WriteCallbackData {
-    std::string data;
-};
+namespace {
+double Now() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
 
-// CURL write callback
-static size_t WriteCallback(void* contents, size_t size, size_t nmemb, WriteCallbackData* userp) {
-    size_t realsize = size * nmemb;
-    userp->data.append((char*)contents, realsize);
-    return realsize;
+// The batch route answers with one { status, body } per event; this
+// turns them back into the responses the single-event routes would give
+HttpResponse EventResponse(const HttpResponse& batch, const json* result) {
+    if (!result) return batch;
+    
+    HttpResponse response;
+    response.statusCode = result->value("status", 500);
+    response.success = response.statusCode >= 200 && response.statusCode < 300;
+    const json& body = result->contains("body") ? (*result)["body"] : json::object();
+    response.data = body.dump();
+    response.contentType = "application/json";
+    if (!response.success) {
+        response.error = body.is_object() && body.contains("error") && body["error"].is_string()
+            ? body["error"].get<std::string>() : "HTTP " + std::to_string(response.statusCode);
+    }
+    return response;
+}
 }
 
-// Request structure for async processing
-struct AuthRequest {
-    std::string url;
-    std::string method;
-    std::string body;
-    std::string headers;
-    AuthCallback authCallback;
-    HttpCallback httpCallback;
-    bool isAuthRequest;
+struct BatchEvent {
+    uint64_t id;
+    json event;                 // Including its "type"
+    HttpCallback callback;
 };
 
 // Implementation details
 struct AuthNetworkManager::Impl {
     std::string baseUrl;
     std::string authToken;
-    std::queue<AuthRequest> requestQueue;
-    std::mutex queueMutex;
-    bool isLoading;
+    int timeoutMs;
+    WireFormat wireFormat;
+    HttpClient* client;
+    int pendingRequests;
     
-    Impl() : baseUrl("http://localhost:3001"), isLoading(false) {
-        curl_global_init(CURL_GLOBAL_DEFAULT);
-    }
+    // Events waiting for the next batch, all under batchToken
+    std::vector<BatchEvent> batch;
+    std::string batchToken;
+    double batchStartTime;
+    uint64_t nextEventId;
     
-    ~Impl() {
-        curl_global_cleanup();
-    }
+    // Expires with this object; responses that arrive later are dropped
+    std::shared_ptr<int> alive;
+    
+    explicit Impl(HttpClient* httpClient)
+        : baseUrl("http://localhost:3000"), timeoutMs(30000), wireFormat(WireFormat::Json), client(httpClient)
+        , pendingRequests(0), batchStartTime(0.0), nextEventId(0), alive(std::make_shared<int>(0)) {}
 };
 
-AuthNetworkManager::AuthNetworkManager() : m_impl(std::make_unique<Impl>()) {}
+AuthNetworkManager::AuthNetworkManager(HttpClient* client) : m_impl(std::make_unique<Impl>(client)) {}
 
 AuthNetworkManager::~AuthNetworkManager() = default;
 
@@ -57,10 +71,18 @@ void AuthNetworkManager::SetBaseUrl(const std::string& baseUrl) {
     m_impl->baseUrl = baseUrl;
 }
 
+void AuthNetworkManager::SetTimeout(int timeoutMs) {
+    m_impl->timeoutMs = timeoutMs;
+}
+
 void AuthNetworkManager::SetAuthToken(const std::string& token) {
     m_impl->authToken = token;
 }
 
+void AuthNetworkManager::SetWireFormat(WireFormat format) {
+    m_impl->wireFormat = format;
+}
+
 void AuthNetworkManager::RegisterEmailUser(const std::string& username, const std::string& email, 
                                           const std::string& password, AuthCallback callback) {
     std::string jsonBody = CreateAuthJson("email", username, email, password);
@@ -114,123 +136,220 @@ void AuthNetworkManager::CheckEmailExists(const std::string& email,
     });
 }
 
-void AuthNetworkManager::Update() {
-    std::lock_guard<std::mutex> lock(m_impl->queueMutex);
-    
-    if (!m_impl->requestQueue.empty()) {
-        AuthRequest request = m_impl->requestQueue.front();
-        m_impl->requestQueue.pop();
-        
-        // Process request asynchronously
-        std::thread([this, request]() {
-            m_impl->isLoading = true;
-            
-            CURL* curl = curl_easy_init();
-            if (curl) {
-                WriteCallbackData writeData;
-                
-                // Set URL
-                std::string fullUrl = m_impl->baseUrl + request.url;
-                curl_easy_setopt(curl, CURLOPT_URL, fullUrl.c_str());
-                
-                // Set method
-                if (request.method == "POST") {
-                    curl_easy_setopt(curl, CURLOPT_POST, 1L);
-                    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body.c_str());
-                } else if (request.method == "GET") {
-                    curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
-                }
-                
-                // Set headers
-                struct curl_slist* headers = nullptr;
-                headers = curl_slist_append(headers, "Content-Type: application/json");
-                if (!m_impl->authToken.empty()) {
-                    std::string authHeader = "Authorization: Bearer " + m_impl->authToken;
-                    headers = curl_slist_append(headers, authHeader.c_str());
-                }
-                curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-                
-                // Set write callback
-                curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-                curl_easy_setopt(curl, CURLOPT_WRITEDATA, &writeData);
-                
-                // Perform request
-                CURLcode res = curl_easy_perform(curl);
-                
-                long httpCode = 0;
-                curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
-                
-                // Clean up
-                curl_slist_free_all(headers);
-                curl_easy_cleanup(curl);
-                
-                // Process response
-                if (res == CURLE_OK) {
-                    if (request.isAuthRequest) {
-                        AuthResponse authResponse = ParseAuthResponse(writeData.data);
-                        authResponse.success = (httpCode >= 200 && httpCode < 300);
-                        if (!authResponse.success && authResponse.error.empty()) {
-                            authResponse.error = "HTTP " + std::to_string(httpCode);
-                        }
-                        request.authCallback(authResponse);
-                    } else {
-                        HttpResponse httpResponse;
-                        httpResponse.success = (httpCode >= 200 && httpCode < 300);
-                        httpResponse.statusCode = httpCode;
-                        httpResponse.data = writeData.data;
-                        if (!httpResponse.success) {
-                            httpResponse.error = "HTTP " + std::to_string(httpCode);
-                        }
-                        request.httpCallback(httpResponse);
-                    }
-                } else {
-                    if (request.isAuthRequest) {
-                        AuthResponse authResponse;
-                        authResponse.success = false;
-                        authResponse.error = curl_easy_strerror(res);
-                        request.authCallback(authResponse);
-                    } else {
-                        HttpResponse httpResponse;
-                        httpResponse.success = false;
-                        httpResponse.error = curl_easy_strerror(res);
-                        request.httpCallback(httpResponse);
-                    }
-                }
-            }
-            
-            m_impl->isLoading = false;
-        }).detach();
-    }
-}
-
 bool AuthNetworkManager::IsLoading() const {
-    return m_impl->isLoading;
+    return m_impl->pendingRequests > 0;
 }
 
 void AuthNetworkManager::MakeAuthRequest(const std::string& endpoint, const std::string& jsonBody, 
                                         AuthCallback callback, const std::string& method) {
-    AuthRequest request;
-    request.url = endpoint;
-    request.method = method;
-    request.body = jsonBody;
-    request.authCallback = callback;
-    request.isAuthRequest = true;
-    
-    std::lock_guard<std::mutex> lock(m_impl->queueMutex);
-    m_impl->requestQueue.push(request);
+    MakeHttpRequest(endpoint, method, jsonBody, [this, callback](const HttpResponse& response) {
+        AuthResponse authResponse;
+        if (response.statusCode == 0) {
+            // Transport failure, no body to parse
+            authResponse.success = false;
+            authResponse.error = response.error;
+        } else {
+            authResponse = ParseAuthResponse(response.data);
+            authResponse.success = response.success;
+            if (!authResponse.success && authResponse.error.empty()) {
+                authResponse.error = response.error;
+            }
+        }
+        callback(authResponse);
+    });
+}
+
+HttpRequestId AuthNetworkManager::MakeHttpRequest(const std::string& endpoint, const std::string& method,
+                                                 const std::string& body, HttpCallback callback) {
+    return SendRequest(endpoint, method, body, GetContentType(WireFormat::Json), m_impl->authToken,
+                       false, std::move(callback));
+}
+
+HttpRequestId AuthNetworkManager::PostGameData(const std::string& endpoint, const json& body,
+                                              const std::string& authToken, HttpCallback callback) {
+    std::string encoded = EncodeBody(body, m_impl->wireFormat);
+    bool gzipped = false;
+    if (encoded.size() >= kCompressThreshold) {
+        std::string compressed;
+        if (GzipCompress(encoded, compressed) && compressed.size() < encoded.size()) {
+            encoded.swap(compressed);
+            gzipped = true;
+        }
+    }
+    return SendRequest(endpoint, "POST", encoded, GetContentType(m_impl->wireFormat), authToken,
+                       gzipped, std::move(callback));
 }
 
-void AuthNetworkManager::MakeHttpRequest(const std::string& endpoint, const std::string& method,
-                                        const std::string& body, HttpCallback callback) {
-    AuthRequest request;
-    request.url = endpoint;
+HttpRequestId AuthNetworkManager::SendRequest(const std::string& endpoint, const std::string& method,
+                                             const std::string& body, const std::string& contentType,
+                                             const std::string& authToken, bool gzipped,
+                                             HttpCallback callback) {
+    HttpRequest request;
     request.method = method;
+    request.url = m_impl->baseUrl + endpoint;
     request.body = body;
-    request.httpCallback = callback;
-    request.isAuthRequest = false;
+    request.timeoutMs = m_impl->timeoutMs;
+    request.headers.push_back("Content-Type: " + contentType);
+    // Ask for the response in the same encoding
+    request.headers.push_back("Accept: " + contentType);
+    if (gzipped) {
+        request.headers.push_back("Content-Encoding: gzip");
+    }
+    if (!authToken.empty()) {
+        request.headers.push_back("Authorization: Bearer " + authToken);
+    }
+    
+    Impl* impl = m_impl.get();
+    impl->pendingRequests++;
+    return impl->client->Send(std::move(request), [impl, callback](const HttpResponse& response) {
+        impl->pendingRequests--;
+        callback(response);
+    }, impl->alive);
+}
+
+void AuthNetworkManager::CancelRequest(HttpRequestId id) {
+    m_impl->client->Cancel(id);
+}
+
+uint64_t AuthNetworkManager::QueueSessionStart(uint64_t seed, const std::string& ref, HttpCallback callback) {
+    // 64-bit seeds don't survive a JavaScript number; send them as 16 hex digits
+    char seedHex[17];
+    snprintf(seedHex, sizeof(seedHex), "%016llx", static_cast<unsigned long long>(seed));
+    
+    json event;
+    event["gameMode"] = "normal";
+    event["seed"] = seedHex;
+    if (!ref.empty()) event["ref"] = ref;
+    return QueueEvent("session_start", std::move(event), std::move(callback));
+}
+
+uint64_t AuthNetworkManager::QueueGameProgress(const std::string& sessionId, const std::string& sessionRef,
+                                              int currentScore, int leaderboardPoints, int skillPoints,
+                                              float survivalTime, int livesRemaining, HttpCallback callback) {
+    json event;
+    if (!sessionId.empty()) event["sessionId"] = sessionId;
+    if (!sessionRef.empty()) event["sessionRef"] = sessionRef;
+    event["currentScore"] = currentScore;
+    event["leaderboardPoints"] = leaderboardPoints;
+    event["skillPoints"] = skillPoints;
+    event["survivalTime"] = survivalTime;
+    event["livesRemaining"] = livesRemaining;
+    return QueueEvent("progress_save", std::move(event), std::move(callback));
+}
+
+uint64_t AuthNetworkManager::QueueSessionEnd(const std::string& sessionId, const std::string& sessionRef,
+                                            int finalScore, int finalLeaderboardPoints, int finalSkillPoints,
+                                            float survivalTime, int kills, int damageDealt,
+                                            int damageTaken, int waveReached, HttpCallback callback) {
+    json event;
+    if (!sessionId.empty()) event["sessionId"] = sessionId;
+    if (!sessionRef.empty()) event["sessionRef"] = sessionRef;
+    event["finalScore"] = finalScore;
+    event["leaderboardPointsEarned"] = finalLeaderboardPoints;
+    event["skillPointsEarned"] = finalSkillPoints;
+    event["survivalTime"] = survivalTime;
+    event["kills"] = kills;
+    event["damageDealt"] = damageDealt;
+    event["damageTaken"] = damageTaken;
+    event["waveReached"] = waveReached;
+    event["endReason"] = "player_death";
+    return QueueEvent("session_end", std::move(event), std::move(callback));
+}
+
+uint64_t AuthNetworkManager::QueueEvent(const std::string& type, json event, HttpCallback callback) {
+    Impl* impl = m_impl.get();
     
-    std::lock_guard<std::mutex> lock(m_impl->queueMutex);
-    m_impl->requestQueue.push(request);
+    // A batch is sent under one user's token
+    if (!impl->batch.empty() && impl->batchToken != impl->authToken) {
+        FlushBatch();
+    }
+    if (impl->batch.empty()) {
+        impl->batchToken = impl->authToken;
+        impl->batchStartTime = Now();
+    }
+    
+    BatchEvent queued;
+    queued.id = ++impl->nextEventId;
+    queued.event = std::move(event);
+    queued.event["type"] = type;
+    queued.callback = std::move(callback);
+    impl->batch.push_back(std::move(queued));
+    
+    uint64_t id = impl->nextEventId;
+    if (impl->batch.size() >= kBatchMaxEvents) {
+        FlushBatch();
+    }
+    return id;
+}
+
+void AuthNetworkManager::UpdateBatch() {
+    Impl* impl = m_impl.get();
+    if (!impl->batch.empty() && Now() - impl->batchStartTime >= kBatchMaxDelay) {
+        FlushBatch();
+    }
+}
+
+void AuthNetworkManager::FlushBatch() {
+    Impl* impl = m_impl.get();
+    if (impl->batch.empty()) return;
+    
+    std::vector<BatchEvent> events;
+    events.swap(impl->batch);
+    
+    json body;
+    json& bodyEvents = body["events"];
+    bodyEvents = json::array();
+    std::vector<HttpCallback> callbacks;
+    callbacks.reserve(events.size());
+    for (BatchEvent& event : events) {
+        bodyEvents.push_back(std::move(event.event));
+        callbacks.push_back(std::move(event.callback));
+    }
+    
+    PostGameData("/api/game/batch", body, impl->batchToken, [callbacks](const HttpResponse& response) {
+        const json* results = nullptr;
+        json root;
+        if (response.success && DecodeBody(response, root)) {
+            if (root.is_object() && root.contains("results") && root["results"].is_array() &&
+                root["results"].size() == callbacks.size()) {
+                results = &root["results"];
+            }
+        }
+        
+        HttpResponse failure = response;
+        if (!results && response.success) {
+            failure.success = false;
+            failure.statusCode = 0;
+            failure.error = "Malformed batch response";
+        } else if (response.statusCode == 404) {
+            // A server without the batch route; worth retrying after an update
+            failure.statusCode = 0;
+            failure.error = "Batch endpoint unavailable";
+        }
+        
+        for (size_t i = 0; i < callbacks.size(); ++i) {
+            HttpResponse eventResponse = EventResponse(failure, results ? &(*results)[i] : nullptr);
+            if (callbacks[i]) callbacks[i](eventResponse);
+        }
+    });
+}
+
+bool AuthNetworkManager::CancelQueuedEvent(uint64_t eventId) {
+    std::vector<BatchEvent>& batch = m_impl->batch;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (batch[i].id != eventId) continue;
+        
+        HttpCallback callback = std::move(batch[i].callback);
+        batch.erase(batch.begin() + i);
+        
+        HttpResponse response;
+        response.success = false;
+        response.statusCode = 0;
+        response.error = "Cancelled";
+        if (callback) callback(response);
+        return true;
+    }
+    return false;
 }
 
 AuthResponse AuthNetworkManager::ParseAuthResponse(const std::string& jsonData) {
@@ -278,45 +397,6 @@ void AuthNetworkManager::GetProgress(HttpCallback callback) {
     MakeHttpRequest("/api/game/progress", "GET", "", callback);
 }
 
-void AuthNetworkManager::StartGameSession(HttpCallback callback) {
-    json requestBody;
-    requestBody["gameMode"] = "normal";
-    MakeHttpRequest("/api/game/session/start", "POST", requestBody.dump(), callback);
-}
-
-void AuthNetworkManager::SaveGameProgress(const std::string& sessionId, int currentScore, 
-                                         int leaderboardPoints, int skillPoints, float survivalTime, 
-                                         int livesRemaining, HttpCallback callback) {
-    json requestBody;
-    requestBody["sessionId"] = sessionId;
-    requestBody["currentScore"] = currentScore;
-    requestBody["leaderboardPoints"] = leaderboardPoints;
-    requestBody["skillPoints"] = skillPoints;
-    requestBody["survivalTime"] = survivalTime;
-    requestBody["livesRemaining"] = livesRemaining;
-    
-    MakeHttpRequest("/api/game/progress/save", "POST", requestBody.dump(), callback);
-}
-
-void AuthNetworkManager::EndGameSession(const std::string& sessionId, int finalScore, 
-                                       int finalLeaderboardPoints, int finalSkillPoints,
-                                       float survivalTime, int kills, int damageDealt, 
-                                       int damageTaken, int waveReached, HttpCallback callback) {
-    json requestBody;
-    requestBody["sessionId"] = sessionId;
-    requestBody["finalScore"] = finalScore;
-    requestBody["leaderboardPointsEarned"] = finalLeaderboardPoints;
-    requestBody["skillPointsEarned"] = finalSkillPoints;
-    requestBody["survivalTime"] = survivalTime;
-    requestBody["kills"] = kills;
-    requestBody["damageDealt"] = damageDealt;
-    requestBody["damageTaken"] = damageTaken;
-    requestBody["waveReached"] = waveReached;
-    requestBody["endReason"] = "player_death";
-    
-    MakeHttpRequest("/api/game/session/end", "POST", requestBody.dump(), callback);
-}
-
 std::string AuthNetworkManager::CreateAuthJson(const std::string& authMethod, const std::string& username,
                                               const std::string& email, const std::string& password,
                                               const std::string& steamId, const std::string& steamData) {
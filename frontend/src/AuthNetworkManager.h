@@ -1,9 +1,12 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <nlohmann/json_fwd.hpp>
 #include "NetworkManager.h"
+#include "WireFormat.h"
 
 // Authentication response structures
 struct AuthResponse {
@@ -25,14 +28,21 @@ struct AuthResponse {
 using AuthCallback = std::function<void(const AuthResponse& response)>;
 using HttpCallback = std::function<void(const HttpResponse& response)>;
 
+class HttpClient;
+
+// Callbacks run on the main thread when Game dispatches network
+// completions, and never after this object is destroyed.
 class AuthNetworkManager {
 public:
-    AuthNetworkManager();
+    explicit AuthNetworkManager(HttpClient* client);
     ~AuthNetworkManager();
 
     // Configuration
     void SetBaseUrl(const std::string& baseUrl);
+    void SetTimeout(int timeoutMs);
     void SetAuthToken(const std::string& token);
+    // Encoding of game session, progress and batch bodies
+    void SetWireFormat(WireFormat format);
     
     // Authentication API calls
     void RegisterEmailUser(const std::string& username, const std::string& email, 
@@ -54,37 +64,65 @@ public:
     void CheckEmailExists(const std::string& email, std::function<void(bool exists, const std::string& error)> callback);
     
     // Game progress API calls
-    void StartGameSession(HttpCallback callback);
-    
-    void SaveGameProgress(const std::string& sessionId, int currentScore, 
-                         int leaderboardPoints, int skillPoints, float survivalTime, 
-                         int livesRemaining, HttpCallback callback);
-    
     void SaveProgress(int leaderboardPoints, int skillPoints, int currentScore, 
                      float survivalTime, HttpCallback callback);
     
     void GetProgress(HttpCallback callback);
     
-    void EndGameSession(const std::string& sessionId, int finalScore, 
-                       int finalLeaderboardPoints, int finalSkillPoints,
-                       float survivalTime, int kills, int damageDealt, 
-                       int damageTaken, int waveReached, HttpCallback callback);
+    // Batched game events
+    //
+    // Queued events go out together as one /api/game/batch request once
+    // kBatchMaxEvents are waiting or the oldest has waited kBatchMaxDelay
+    // seconds. Each callback receives its own event's result. Events name
+    // their session either by server id or by the ref given to a
+    // QueueSessionStart earlier in the same batch (pass one, leave the
+    // other empty). Events queued under different auth tokens go in
+    // separate batches.
+    static constexpr size_t kBatchMaxEvents = 32;
+    static constexpr double kBatchMaxDelay = 2.0;
+    
+    // The seed is recorded with the session so the run can be replayed
+    uint64_t QueueSessionStart(uint64_t seed, const std::string& ref, HttpCallback callback);
     
-    // Update method for processing async requests
-    void Update();
+    uint64_t QueueGameProgress(const std::string& sessionId, const std::string& sessionRef,
+                               int currentScore, int leaderboardPoints, int skillPoints,
+                               float survivalTime, int livesRemaining, HttpCallback callback);
+    
+    uint64_t QueueSessionEnd(const std::string& sessionId, const std::string& sessionRef,
+                             int finalScore, int finalLeaderboardPoints, int finalSkillPoints,
+                             float survivalTime, int kills, int damageDealt,
+                             int damageTaken, int waveReached, HttpCallback callback);
+    
+    // Sends the batch if it's due; call once per frame while events are queued
+    void UpdateBatch();
+    void FlushBatch();
+    
+    // Only events still waiting in the batch can be cancelled; their
+    // callback runs with a "Cancelled" error. Returns false otherwise.
+    bool CancelQueuedEvent(uint64_t eventId);
     
     // Check if network operations are in progress
     bool IsLoading() const;
 
     // Make HTTP request (public for development authentication)
-    void MakeHttpRequest(const std::string& endpoint, const std::string& method,
-                        const std::string& body, HttpCallback callback);
+    HttpRequestId MakeHttpRequest(const std::string& endpoint, const std::string& method,
+                                 const std::string& body, HttpCallback callback);
+    
+    // The callback still runs, with a "Cancelled" error
+    void CancelRequest(HttpRequestId id);
 
 private:
     struct Impl;
     std::unique_ptr<Impl> m_impl;
     
     // HTTP request helpers
+    HttpRequestId SendRequest(const std::string& endpoint, const std::string& method,
+                              const std::string& body, const std::string& contentType,
+                              const std::string& authToken, bool gzipped, HttpCallback callback);
+    // POSTs in the configured wire format, gzipped when large
+    HttpRequestId PostGameData(const std::string& endpoint, const nlohmann::json& body,
+                               const std::string& authToken, HttpCallback callback);
+    uint64_t QueueEvent(const std::string& type, nlohmann::json event, HttpCallback callback);
     void MakeAuthRequest(const std::string& endpoint, const std::string& jsonBody, 
                         AuthCallback callback, const std::string& method = "POST");
     
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+
+// Circle tessellation for Renderer::DrawCircle.
+//
+// The unit circle is tabulated at compile time so drawing a circle never
+// calls sin/cos. Lower LODs walk the same table with a larger stride.
+namespace CircleMesh {
+
+constexpr int kMaxSegments = 64;
+constexpr double kPi = 3.14159265358979323846;
+
+constexpr double ConstexprSin(double angle) {
+    // Reduce to [-pi, pi] and sum the Taylor series
+    while (angle > kPi) angle -= 2.0 * kPi;
+    while (angle < -kPi) angle += 2.0 * kPi;
+    double term = angle;
+    double sum = angle;
+    for (int n = 1; n < 12; ++n) {
+        term *= -angle * angle / ((2.0 * n) * (2.0 * n + 1.0));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double ConstexprCos(double angle) {
+    return ConstexprSin(angle + kPi / 2.0);
+}
+
+struct UnitCircleTable {
+    float x[kMaxSegments + 1];
+    float y[kMaxSegments + 1];
+};
+
+constexpr UnitCircleTable MakeUnitCircleTable() {
+    UnitCircleTable table{};
+    for (int i = 0; i <= kMaxSegments; ++i) {
+        double angle = 2.0 * kPi * i / kMaxSegments;
+        table.x[i] = static_cast<float>(ConstexprCos(angle));
+        table.y[i] = static_cast<float>(ConstexprSin(angle));
+    }
+    // Close the loop exactly so the last wedge has no seam
+    table.x[kMaxSegments] = 1.0f;
+    table.y[kMaxSegments] = 0.0f;
+    return table;
+}
+
+constexpr UnitCircleTable kUnitCircle = MakeUnitCircleTable();
+
+// Pick a segment count (a divisor of kMaxSegments) from the on-screen
+// radius in pixels: 8 for the cursor trail, 64 for large glows.
+inline int SegmentsForRadius(float pixelRadius) {
+    if (pixelRadius < 6.0f) return 8;
+    if (pixelRadius < 16.0f) return 16;
+    if (pixelRadius < 40.0f) return 32;
+    return 64;
+}
+
+// Writes the circle as a triangle fan unrolled into a triangle list
+// (segments * 3 vertices), so it can join a batch of other triangles
+template <typename Vertex>
+void WriteTriangles(Vertex* out, int segments, float x, float y, float radius, uint32_t color) {
+    const int stride = kMaxSegments / segments;
+
+    float prevX = x + radius;
+    float prevY = y;
+    for (int i = stride; i <= kMaxSegments; i += stride) {
+        float nextX = x + kUnitCircle.x[i] * radius;
+        float nextY = y + kUnitCircle.y[i] * radius;
+        *out++ = {x, y, color};
+        *out++ = {prevX, prevY, color};
+        *out++ = {nextX, nextY, color};
+        prevX = nextX;
+        prevY = nextY;
+    }
+}
+
+} // namespace CircleMesh
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Renderer.h"
+
+// Gameplay components for the PlayState world. All plain data; behaviour
+// lives in the systems PlayState registers.
+
+// Vector components are two packed floats so a column is an interleaved
+// x, y stream the movement kernels can load directly
+struct Position {
+    float x, y;
+};
+
+// Position at the previous simulation tick, for render interpolation
+struct PreviousPosition {
+    float x, y;
+};
+
+struct Velocity {
+    float x, y;
+};
+
+// Accelerates towards the player every tick
+struct Steering {
+    float acceleration;
+};
+
+// Circle used by the collision system
+struct Collider {
+    float radius;
+};
+
+// Costs the player lives on contact and is destroyed
+struct Hostile {
+    int damage;
+};
+
+// Awards score on contact and is destroyed
+struct Pickup {
+    int score;
+};
+
+// Running phase for pulsing effects
+struct Pulse {
+    float time;
+};
+
+// Instanced shape the render system draws at the entity's position
+struct Sprite {
+    ShapeType shape;
+    float size;
+    float r, g, b, a;
+};
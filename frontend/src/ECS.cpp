@@ -0,0 +1,163 @@
+#include "ECS.h"
+#include <iostream>
+#include <cstdlib>
+#include <mutex>
+
+int ComponentRegistry::Register(size_t size) {
+    // Systems on different threads may see a component type first at the
+    // same time
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::vector<size_t>& sizes = Sizes();
+    if (sizes.size() >= static_cast<size_t>(kMaxComponents)) {
+        std::cerr << "Too many component types (max " << kMaxComponents << ")" << std::endl;
+        std::abort();
+    }
+    sizes.push_back(size);
+    return static_cast<int>(sizes.size() - 1);
+}
+
+std::vector<size_t>& ComponentRegistry::Sizes() {
+    static std::vector<size_t> sizes;
+    return sizes;
+}
+
+Archetype::Archetype(ComponentMask mask)
+    : m_mask(mask)
+{
+    for (int id = 0; id < ComponentRegistry::kMaxComponents; ++id) {
+        m_columnOf[id] = -1;
+        if (mask & (ComponentMask(1) << id)) {
+            m_columnOf[id] = static_cast<int8_t>(m_columns.size());
+            m_columns.push_back({ id, ComponentRegistry::GetSize(id), {} });
+        }
+    }
+}
+
+void* Archetype::GetColumn(int componentId) {
+    return m_columns[m_columnOf[componentId]].data.data();
+}
+
+void Archetype::Reserve(size_t count) {
+    m_entities.reserve(count);
+    for (Column& column : m_columns) {
+        column.data.reserve(count * column.elementSize);
+    }
+}
+
+void Archetype::Clear() {
+    m_entities.clear();
+    for (Column& column : m_columns) {
+        column.data.clear();
+    }
+}
+
+size_t Archetype::AddRow(Entity entity) {
+    m_entities.push_back(entity);
+    for (Column& column : m_columns) {
+        column.data.resize(column.data.size() + column.elementSize);
+    }
+    return m_entities.size() - 1;
+}
+
+Entity Archetype::RemoveRow(size_t row) {
+    size_t last = m_entities.size() - 1;
+    if (row != last) {
+        m_entities[row] = m_entities[last];
+        for (Column& column : m_columns) {
+            std::memcpy(&column.data[row * column.elementSize], &column.data[last * column.elementSize],
+                        column.elementSize);
+        }
+    }
+
+    Entity moved = m_entities[row];
+    m_entities.pop_back();
+    for (Column& column : m_columns) {
+        column.data.resize(column.data.size() - column.elementSize);
+    }
+    return moved;
+}
+
+void World::Destroy(Entity entity) {
+    if (!IsAlive(entity)) return;
+
+    EntityRecord& record = m_records[entity.index];
+    Archetype& archetype = m_archetypes[record.archetype];
+    uint32_t row = record.row;
+    Entity moved = archetype.RemoveRow(row);
+    if (moved != entity) {
+        m_records[moved.index].row = row;
+    }
+
+    // Bumping the generation invalidates every outstanding handle
+    record.generation++;
+    record.archetype = -1;
+    m_freeIndices.push_back(entity.index);
+    m_liveCount--;
+}
+
+void World::FlushDestroyed() {
+    if (m_pendingDestroy.empty()) return;
+
+    // Destroy() ignores handles that are already dead, so an entity queued
+    // twice in one pass is fine
+    for (const Entity& entity : m_pendingDestroy) {
+        Destroy(entity);
+    }
+    m_pendingDestroy.clear();
+}
+
+bool World::IsAlive(Entity entity) const {
+    return entity.index < m_records.size() &&
+           m_records[entity.index].generation == entity.generation &&
+           m_records[entity.index].archetype >= 0;
+}
+
+void World::Clear() {
+    // Keep archetypes (and their column capacity) but drop every entity
+    for (size_t i = 0; i < m_records.size(); ++i) {
+        EntityRecord& record = m_records[i];
+        if (record.archetype < 0) continue;
+
+        record.generation++;
+        record.archetype = -1;
+        m_freeIndices.push_back(static_cast<uint32_t>(i));
+    }
+    for (Archetype& archetype : m_archetypes) {
+        archetype.Clear();
+    }
+    m_pendingDestroy.clear();
+    m_liveCount = 0;
+}
+
+void World::ReserveEntities(size_t count) {
+    m_records.reserve(count);
+    m_freeIndices.reserve(count);
+    m_pendingDestroy.reserve(count);
+}
+
+size_t World::FindOrCreateArchetype(ComponentMask mask) {
+    auto it = m_archetypeByMask.find(mask);
+    if (it != m_archetypeByMask.end()) {
+        return it->second;
+    }
+
+    m_archetypes.emplace_back(mask);
+    m_archetypeByMask[mask] = m_archetypes.size() - 1;
+    return m_archetypes.size() - 1;
+}
+
+Entity World::AllocateEntity() {
+    Entity entity;
+    if (!m_freeIndices.empty()) {
+        entity.index = m_freeIndices.back();
+        m_freeIndices.pop_back();
+    } else {
+        entity.index = static_cast<uint32_t>(m_records.size());
+        m_records.emplace_back();
+    }
+    entity.generation = m_records[entity.index].generation;
+    m_liveCount++;
+    return entity;
+}
@@ -0,0 +1,319 @@
+#pragma once
+
+#include "JobSystem.h"
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <deque>
+#include <memory>
+#include <initializer_list>
+
+// Compact archetype-based entity-component-system.
+//
+// Entities with the same set of component types share an archetype, which
+// stores each component type in its own dense column. Systems iterate over
+// whole columns (chunks), so hot loops see contiguous arrays and can run
+// batched/SIMD kernels. Entities are referred to by generational handles: a
+// handle to a destroyed entity never aliases the entity reusing its slot.
+//
+// Components must be trivially copyable; columns are moved with memcpy and
+// a World can be copied as a snapshot. An entity's component set is fixed
+// when it is created.
+
+struct Entity {
+    uint32_t index = 0;
+    uint32_t generation = 0;
+
+    bool operator==(const Entity& o) const { return index == o.index && generation == o.generation; }
+    bool operator!=(const Entity& o) const { return !(*this == o); }
+};
+
+typedef uint64_t ComponentMask;
+
+class ComponentRegistry {
+public:
+    static constexpr int kMaxComponents = 64;
+
+    // Stable id per component type, assigned on first use
+    template <typename T>
+    static int GetId() {
+        static_assert(std::is_trivially_copyable<T>::value, "Components must be trivially copyable");
+        static const int id = Register(sizeof(T));
+        return id;
+    }
+
+    static size_t GetSize(int id) { return Sizes()[id]; }
+
+private:
+    static int Register(size_t size);
+    static std::vector<size_t>& Sizes();
+};
+
+template <typename... Ts>
+ComponentMask MaskOf() {
+    ComponentMask mask = 0;
+    using Expand = int[];
+    (void)Expand{ 0, (mask |= ComponentMask(1) << ComponentRegistry::GetId<Ts>(), 0)... };
+    return mask;
+}
+
+// One archetype: a component set and a column per component type
+class Archetype {
+public:
+    explicit Archetype(ComponentMask mask);
+
+    ComponentMask GetMask() const { return m_mask; }
+    size_t GetCount() const { return m_entities.size(); }
+    const Entity* GetEntities() const { return m_entities.data(); }
+
+    bool Has(int componentId) const { return m_columnOf[componentId] >= 0; }
+    void* GetColumn(int componentId);
+
+    void Reserve(size_t count);
+    void Clear();
+
+    // Appends a row with uninitialized components, returns its index
+    size_t AddRow(Entity entity);
+    // Swap-and-pop; returns the entity moved into the row (or the removed
+    // one when it was the last row)
+    Entity RemoveRow(size_t row);
+
+private:
+    struct Column {
+        int componentId;
+        size_t elementSize;
+        std::vector<uint8_t> data;
+    };
+
+    ComponentMask m_mask;
+    std::vector<Column> m_columns;
+    int8_t m_columnOf[ComponentRegistry::kMaxComponents];
+    std::vector<Entity> m_entities;
+};
+
+// View of one archetype's rows handed to ForEachChunk callbacks
+class ChunkView {
+public:
+    explicit ChunkView(Archetype& archetype) : m_archetype(archetype) {}
+
+    size_t GetCount() const { return m_archetype.GetCount(); }
+    const Entity* GetEntities() const { return m_archetype.GetEntities(); }
+
+    // Column for T, or nullptr if this archetype has no T
+    template <typename T>
+    T* Get() const {
+        int id = ComponentRegistry::GetId<T>();
+        return m_archetype.Has(id) ? static_cast<T*>(m_archetype.GetColumn(id)) : nullptr;
+    }
+
+private:
+    Archetype& m_archetype;
+};
+
+class World {
+public:
+    World() = default;
+    ~World() = default;
+
+    template <typename... Ts>
+    Entity Create(const Ts&... components);
+
+    // Immediate destruction; must not be called while iterating
+    void Destroy(Entity entity);
+    // Deferred destruction for use inside ForEachChunk; applied by FlushDestroyed()
+    void QueueDestroy(Entity entity) { m_pendingDestroy.push_back(entity); }
+    void FlushDestroyed();
+
+    bool IsAlive(Entity entity) const;
+    void Clear();
+
+    // Reserves rows in the archetype for the given component set
+    template <typename... Ts>
+    void Reserve(size_t count);
+    // Reserves entity slots and the deferred-destroy queue, so that creating
+    // and destroying up to 'count' entities never allocates
+    void ReserveEntities(size_t count);
+
+    template <typename T>
+    T* Get(Entity entity);
+
+    // Calls fn(ChunkView&) for every non-empty archetype that has all of Ts
+    template <typename... Ts, typename Fn>
+    void ForEachChunk(Fn&& fn);
+
+    // Number of live entities that have all of Ts
+    template <typename... Ts>
+    size_t Count() const;
+
+    size_t GetEntityCount() const { return m_liveCount; }
+
+private:
+    struct EntityRecord {
+        uint32_t generation = 0;
+        int32_t archetype = -1;     // -1 while the slot is free
+        uint32_t row = 0;
+    };
+
+    std::vector<Archetype> m_archetypes;
+    std::unordered_map<ComponentMask, size_t> m_archetypeByMask;
+    std::vector<EntityRecord> m_records;
+    std::vector<uint32_t> m_freeIndices;
+    std::vector<Entity> m_pendingDestroy;
+    size_t m_liveCount = 0;
+
+    size_t FindOrCreateArchetype(ComponentMask mask);
+    Entity AllocateEntity();
+
+    template <typename T>
+    static void WriteComponent(Archetype& archetype, size_t row, const T& component) {
+        T* column = static_cast<T*>(archetype.GetColumn(ComponentRegistry::GetId<T>()));
+        std::memcpy(&column[row], &component, sizeof(T));
+    }
+};
+
+template <typename... Ts>
+Entity World::Create(const Ts&... components) {
+    size_t archetypeIndex = FindOrCreateArchetype(MaskOf<Ts...>());
+    Archetype& archetype = m_archetypes[archetypeIndex];
+
+    Entity entity = AllocateEntity();
+    size_t row = archetype.AddRow(entity);
+
+    using Expand = int[];
+    (void)Expand{ 0, (WriteComponent(archetype, row, components), 0)... };
+
+    EntityRecord& record = m_records[entity.index];
+    record.archetype = static_cast<int32_t>(archetypeIndex);
+    record.row = static_cast<uint32_t>(row);
+    return entity;
+}
+
+template <typename... Ts>
+void World::Reserve(size_t count) {
+    m_archetypes[FindOrCreateArchetype(MaskOf<Ts...>())].Reserve(count);
+}
+
+template <typename T>
+T* World::Get(Entity entity) {
+    if (!IsAlive(entity)) return nullptr;
+    const EntityRecord& record = m_records[entity.index];
+    Archetype& archetype = m_archetypes[record.archetype];
+    int id = ComponentRegistry::GetId<T>();
+    if (!archetype.Has(id)) return nullptr;
+    return static_cast<T*>(archetype.GetColumn(id)) + record.row;
+}
+
+template <typename... Ts, typename Fn>
+void World::ForEachChunk(Fn&& fn) {
+    ComponentMask mask = MaskOf<Ts...>();
+    for (Archetype& archetype : m_archetypes) {
+        if ((archetype.GetMask() & mask) == mask && archetype.GetCount() > 0) {
+            ChunkView chunk(archetype);
+            fn(chunk);
+        }
+    }
+}
+
+template <typename... Ts>
+size_t World::Count() const {
+    ComponentMask mask = MaskOf<Ts...>();
+    size_t count = 0;
+    for (const Archetype& archetype : m_archetypes) {
+        if ((archetype.GetMask() & mask) == mask) {
+            count += archetype.GetCount();
+        }
+    }
+    return count;
+}
+
+// Systems per phase with their ordering constraints. Context carries
+// whatever the host passes to its systems each run (delta time, renderer,
+// ...).
+//
+// Without a job system (or without workers) a phase runs its systems in
+// registration order and applies deferred destructions after each one.
+// With one, the phase runs as a task graph: a system starts once every
+// system listed in its 'after' set is done, independent systems run
+// concurrently, and deferred destructions are applied when the phase ends.
+// Systems that may run concurrently must not touch the same columns or
+// queue destructions at the same time.
+template <typename Context>
+class SystemScheduler {
+public:
+    typedef std::function<void(World&, const Context&)> SystemFn;
+
+    // Every name in 'after' must already be registered in the same phase
+    void Add(int phase, const char* name, SystemFn system, std::initializer_list<const char*> after = {}) {
+        System entry;
+        entry.phase = phase;
+        entry.name = name;
+        entry.run = std::move(system);
+        entry.owner = this;
+        for (const char* dependency : after) {
+            for (size_t i = 0; i < m_systems.size(); ++i) {
+                if (m_systems[i].phase == phase && m_systems[i].name == dependency) {
+                    entry.after.push_back(static_cast<int>(i));
+                }
+            }
+        }
+        m_systems.push_back(std::move(entry));
+        m_graphs.clear();
+    }
+
+    void Run(int phase, World& world, const Context& context, JobSystem* jobs = nullptr) {
+        if (!jobs || jobs->GetWorkerCount() == 0) {
+            for (System& system : m_systems) {
+                if (system.phase != phase) continue;
+                system.run(world, context);
+                world.FlushDestroyed();
+            }
+            return;
+        }
+
+        m_runWorld = &world;
+        m_runContext = &context;
+        GetGraph(phase).Run(*jobs);
+        world.FlushDestroyed();
+    }
+
+private:
+    struct System {
+        int phase;
+        std::string name;
+        SystemFn run;
+        std::vector<int> after;
+        SystemScheduler* owner;
+    };
+
+    std::deque<System> m_systems;
+    std::unordered_map<int, std::unique_ptr<TaskGraph>> m_graphs;
+    World* m_runWorld = nullptr;
+    const Context* m_runContext = nullptr;
+
+    // Built on first use and kept until the system list changes
+    TaskGraph& GetGraph(int phase) {
+        std::unique_ptr<TaskGraph>& graph = m_graphs[phase];
+        if (!graph) {
+            graph.reset(new TaskGraph());
+            std::vector<int> taskOf(m_systems.size(), -1);
+            for (size_t i = 0; i < m_systems.size(); ++i) {
+                if (m_systems[i].phase != phase) continue;
+                taskOf[i] = graph->AddTask(&SystemScheduler::RunSystem, &m_systems[i]);
+                for (int dependency : m_systems[i].after) {
+                    graph->AddDependency(taskOf[dependency], taskOf[i]);
+                }
+            }
+        }
+        return *graph;
+    }
+
+    static void RunSystem(void* data) {
+        System* system = static_cast<System*>(data);
+        system->run(*system->owner->m_runWorld, *system->owner->m_runContext);
+    }
+};
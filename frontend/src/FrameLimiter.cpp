@@ -0,0 +1,161 @@
+#include "FrameLimiter.h"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Time left between the end of the frame's work and the swap deadline in low
+// latency mode, to absorb frames that run a little over the estimate
+constexpr double kLowLatencyMargin = 0.001;
+
+// Bounds for the part of the wait that is spun instead of slept
+constexpr double kMinSleepSlack = 0.0005;
+constexpr double kMaxSleepSlack = 0.004;
+}
+
+FrameLimiter::FrameLimiter()
+    : m_frequency(static_cast<double>(SDL_GetPerformanceFrequency()))
+    , m_targetFps(0)
+    , m_vsync(false)
+    , m_refreshRate(60)
+    , m_period(0.0)
+    , m_lowLatency(false)
+    , m_workEstimate(0.0)
+    , m_sleepSlack(0.002)
+    , m_slotStart(0)
+    , m_frameStart(0)
+    , m_lastFrameStart(0)
+    , m_started(false)
+    , m_statFrames(0)
+    , m_statSum(0.0)
+    , m_statSumSquares(0.0)
+    , m_statMax(0.0)
+{
+}
+
+void FrameLimiter::SetTargetFps(int fps) {
+    m_targetFps = std::max(fps, 0);
+    UpdatePeriod();
+}
+
+void FrameLimiter::SetVSync(bool vsync, int refreshRate) {
+    m_vsync = vsync;
+    m_refreshRate = refreshRate > 0 ? refreshRate : 60;
+    UpdatePeriod();
+}
+
+void FrameLimiter::UpdatePeriod() {
+    if (m_vsync) {
+        m_period = 1.0 / m_refreshRate;
+    } else if (m_targetFps > 0) {
+        m_period = 1.0 / m_targetFps;
+    } else {
+        m_period = 0.0;
+    }
+}
+
+void FrameLimiter::BeginFrame() {
+    if (!m_started) {
+        m_started = true;
+        m_slotStart = Now();
+        m_frameStart = m_slotStart;
+        m_lastFrameStart = m_slotStart;
+        return;
+    }
+
+    if (m_period > 0.0) {
+        uint64_t target = m_slotStart;
+
+        // Start as late as the recent frames allow so input is sampled as
+        // close to the swap as possible
+        if (m_lowLatency) {
+            double delay = m_period - m_workEstimate - kLowLatencyMargin;
+            if (delay > 0.0) {
+                target += ToTicks(delay);
+            }
+        }
+
+        WaitUntil(target);
+    }
+
+    m_frameStart = Now();
+
+    double frameTime = ToSeconds(m_frameStart - m_lastFrameStart);
+    m_lastFrameStart = m_frameStart;
+
+    m_statFrames++;
+    m_statSum += frameTime;
+    m_statSumSquares += frameTime * frameTime;
+    m_statMax = std::max(m_statMax, frameTime);
+}
+
+void FrameLimiter::EndFrame() {
+    uint64_t now = Now();
+
+    // Rises immediately on a slow frame and decays slowly, so one fast frame
+    // doesn't push the next start too late
+    double work = ToSeconds(now - m_frameStart);
+    m_workEstimate = std::max(work, m_workEstimate * 0.98 + work * 0.02);
+
+    if (m_vsync || m_period <= 0.0) {
+        // The swap returned on the display's schedule (or there is none)
+        m_slotStart = now;
+    } else {
+        // Fixed grid so the average rate stays exact; after a long frame
+        // start over from now rather than rushing to catch up
+        m_slotStart += ToTicks(m_period);
+        if (m_slotStart < now) {
+            m_slotStart = now;
+        }
+    }
+}
+
+FrameLimiter::Stats FrameLimiter::ConsumeStats() {
+    Stats stats;
+    if (m_statFrames > 0) {
+        double mean = m_statSum / m_statFrames;
+        double variance = std::max(m_statSumSquares / m_statFrames - mean * mean, 0.0);
+
+        stats.frames = m_statFrames;
+        stats.meanMs = static_cast<float>(mean * 1000.0);
+        stats.jitterMs = static_cast<float>(std::sqrt(variance) * 1000.0);
+        stats.maxMs = static_cast<float>(m_statMax * 1000.0);
+    }
+
+    m_statFrames = 0;
+    m_statSum = 0.0;
+    m_statSumSquares = 0.0;
+    m_statMax = 0.0;
+    return stats;
+}
+
+uint64_t FrameLimiter::Now() const {
+    return SDL_GetPerformanceCounter();
+}
+
+void FrameLimiter::WaitUntil(uint64_t target) {
+    for (;;) {
+        uint64_t now = Now();
+        if (now >= target) {
+            return;
+        }
+
+        double remaining = ToSeconds(target - now);
+        Uint32 sleepMs = static_cast<Uint32>((remaining - m_sleepSlack) * 1000.0);
+        if (remaining <= m_sleepSlack || sleepMs == 0) {
+            // Spin out the last stretch; SDL_Delay can't hit it reliably
+            continue;
+        }
+
+        SDL_Delay(sleepMs);
+
+        // Learn how far the OS overshoots a sleep and keep that much in reserve
+        double overshoot = ToSeconds(Now() - now) - sleepMs / 1000.0;
+        if (overshoot > m_sleepSlack) {
+            m_sleepSlack = overshoot;
+        } else {
+            m_sleepSlack = m_sleepSlack * 0.99 + overshoot * 0.01;
+        }
+        m_sleepSlack = std::clamp(m_sleepSlack, kMinSleepSlack, kMaxSleepSlack);
+    }
+}
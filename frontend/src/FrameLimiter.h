@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+
+// Paces the main loop on the high-resolution performance counter.
+//
+// Without VSync it caps the loop at the target frame rate, sleeping for most
+// of the idle time and spinning only for the last stretch where SDL_Delay is
+// too coarse. With VSync the swap already paces the loop, so the limiter only
+// matters in low latency mode: there it delays the start of the frame (input
+// polling, simulation, rendering) so the work finishes just before the next
+// swap instead of waiting on it with stale input.
+class FrameLimiter {
+public:
+    // Frame time statistics over the frames since the last ConsumeStats()
+    struct Stats {
+        int frames = 0;
+        float meanMs = 0.0f;
+        float jitterMs = 0.0f;   // Standard deviation of the frame time
+        float maxMs = 0.0f;
+    };
+
+    FrameLimiter();
+    ~FrameLimiter() = default;
+
+    // 0 disables the cap (used when VSync paces the loop)
+    void SetTargetFps(int fps);
+    int GetTargetFps() const { return m_targetFps; }
+
+    // With VSync the frame period is the display refresh and the swap is the
+    // reference point; without it frames are scheduled on a fixed grid
+    void SetVSync(bool vsync, int refreshRate);
+
+    void SetLowLatency(bool enabled) { m_lowLatency = enabled; }
+    bool IsLowLatency() const { return m_lowLatency; }
+
+    // Call before polling input; waits until the frame should start
+    void BeginFrame();
+    // Call right after the buffer swap
+    void EndFrame();
+
+    Stats ConsumeStats();
+
+private:
+    double m_frequency;
+
+    int m_targetFps;
+    bool m_vsync;
+    int m_refreshRate;
+    double m_period;            // Seconds per frame, 0 = uncapped
+
+    bool m_lowLatency;
+    double m_workEstimate;      // Recent peak of input-to-swap time
+
+    // Sleep granularity learned from how far SDL_Delay overshoots
+    double m_sleepSlack;
+
+    uint64_t m_slotStart;       // When the current frame slot began
+    uint64_t m_frameStart;      // When the last frame actually started
+    uint64_t m_lastFrameStart;
+    bool m_started;
+
+    // Running sums for Stats
+    int m_statFrames;
+    double m_statSum;
+    double m_statSumSquares;
+    double m_statMax;
+
+    uint64_t Now() const;
+    double ToSeconds(uint64_t ticks) const { return ticks / m_frequency; }
+    uint64_t ToTicks(double seconds) const { return static_cast<uint64_t>(seconds * m_frequency); }
+    void UpdatePeriod();
+    void WaitUntil(uint64_t target);
+};
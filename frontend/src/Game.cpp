@@ -5,25 +5,51 @@
 #include "Renderer.h"
 #include "Input.h"
 #include "Audio.h"
+#include "Viewport.h"
+#include "FrameLimiter.h"
+#include "JobSystem.h"
+#include "HttpClient.h"
+#include "SessionJournal.h"
+#include "AllocationCounter.h"
 #include <iostream>
 #include <cstring>
+#include <cstdio>
+#include <algorithm>
 #include <imgui.h>
 #include <backends/imgui_impl_sdl2.h>
 #include <backends/imgui_impl_opengl3.h>
 
+namespace {
+// Longest frame the simulation will catch up on. Anything beyond this (a
+// breakpoint, a window drag) is dropped instead of replayed as a burst of
+// ticks, which would make the next frame even slower.
+constexpr double kMaxFrameTime = 0.25;
+
+// Main thread time per frame for network callbacks; a burst of responses
+// is spread over the following frames instead of causing a hitch
+constexpr double kNetworkDispatchBudget = 0.002;
+}
+
 Game::Game() 
     : m_window(nullptr)
     , m_glContext(nullptr)
-    , m_screenWidth(1280)
-    , m_screenHeight(720)
+    , m_screenWidth(m_config.window.width)
+    , m_screenHeight(m_config.window.height)
     , m_fullscreen(false)
-    , m_vsync(true)
+    , m_vsync(m_config.window.vsync)
     , m_running(false)
-    , m_lastFrameTime(0)
+    , m_pipelined(true)
+    , m_lastFrameCounter(0)
+    , m_counterFrequency(1.0)
     , m_deltaTime(0.0f)
+    , m_physicsFps(m_config.game.physicsFps)
+    , m_fixedDeltaTime(1.0f / m_config.game.physicsFps)
+    , m_accumulator(0.0)
+    , m_interpolationAlpha(1.0f)
     , m_frameCount(0)
-    , m_fpsTimer(0)
+    , m_fpsCounter(0)
     , m_fps(0.0f)
+    , m_fpsAllocationCount(0)
 {
 }
 
@@ -32,6 +58,9 @@ Game::~Game() {
 }
 
 bool Game::Initialize() {
+    // Window size, vsync and the rest come from the config
+    LoadConfig();
+    
     // Initialize SDL
     if (!InitializeSDL()) {
         std::cerr << "Failed to initialize SDL!" << std::endl;
@@ -45,6 +74,12 @@ bool Game::Initialize() {
     }
     
     // Core systems
+    m_viewport = std::make_unique<Viewport>();
+    m_viewport->SetWindowSize(m_screenWidth, m_screenHeight);
+    
+    m_frameLimiter = std::make_unique<FrameLimiter>();
+    m_frameLimiter->SetVSync(m_vsync, GetDisplayRefreshRate());
+    
     m_renderer = std::make_unique<Renderer>();
     if (!m_renderer->Initialize()) {
         std::cerr << "Failed to initialize renderer!" << std::endl;
@@ -63,6 +98,30 @@ bool Game::Initialize() {
         return false;
     }
     
+    // Frame rates, render scale, fullscreen
+    ApplyConfig();
+    
+    // One worker per remaining core; the main thread helps while it waits
+    m_jobSystem = std::make_unique<JobSystem>();
+    if (!m_jobSystem->Initialize(std::max(SDL_GetCPUCount() - 1, 0))) {
+        std::cerr << "Failed to initialize job system!" << std::endl;
+        return false;
+    }
+    
+    // Shared by every state; without it requests fail and the game plays offline
+    m_httpClient = std::make_unique<HttpClient>();
+    if (!m_httpClient->Initialize()) {
+        std::cerr << "Failed to initialize HTTP client, continuing offline" << std::endl;
+    }
+    
+    // Session events go to disk first and are uploaded from there; without
+    // a data directory they're kept in memory for this run only
+    m_sessionJournal = std::make_unique<SessionJournal>(m_httpClient.get());
+    ApplyNetworkConfig();
+    if (m_prefPath.empty() || !m_sessionJournal->Open(m_prefPath + "session_journal.jsonl")) {
+        std::cerr << "Session journal unavailable, offline sessions won't survive a restart" << std::endl;
+    }
+    
     // Initialize ImGui
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
@@ -92,8 +151,10 @@ bool Game::Initialize() {
     PushState(std::make_unique<AuthChoiceState>(this));
     
     m_running = true;
-    m_lastFrameTime = SDL_GetTicks();
-    m_fpsTimer = SDL_GetTicks();
+    m_counterFrequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    m_lastFrameCounter = SDL_GetPerformanceCounter();
+    m_fpsCounter = m_lastFrameCounter;
+    m_accumulator = 0.0;
     
     std::cout << "Game initialized successfully!" << std::endl;
     return true;
@@ -101,12 +162,48 @@ bool Game::Initialize() {
 
 void Game::Run() {
     while (m_running && !m_states.empty()) {
+        // Sleep off the rest of the frame budget (or, in low latency mode,
+        // hold back input polling) before this frame starts
+        m_frameLimiter->BeginFrame();
+        
         CalculateDeltaTime();
         UpdateFPS();
         
+#ifndef NDEBUG
+        // Hot reload; the simulation worker is idle here
+        if (m_configWatcher && m_configWatcher->Poll()) {
+            ReloadConfig();
+        }
+#endif
+        
+        // Pressed/released edges are relative to the last frame, so the
+        // state rolls over before this frame's events and every tick sees them
+        if (m_input) {
+            m_input->Update();
+        }
         HandleEvents();
-        Update(m_deltaTime);
-        Render();
+        if (m_states.empty()) break;
+        
+        // Network callbacks run here, on the main thread with the simulation
+        // worker idle, so they may change state freely
+        m_httpClient->Dispatch(kNetworkDispatchBudget);
+        if (m_states.empty()) break;
+        m_sessionJournal->Update();
+        
+        if (m_pipelined && m_states.top()->UsesRenderSnapshot()) {
+            // Simulate the next frame on a worker while this thread submits
+            // the last snapshot. Events and UI run with the worker joined,
+            // so they may still touch the state directly.
+            JobCounter simulation;
+            m_jobSystem->Submit(&Game::SimulateJob, this, 0, 0, &simulation);
+            RenderScene();
+            m_jobSystem->Wait(simulation);
+            RenderOverlay();
+        } else {
+            Simulate();
+            Render();
+        }
+        m_frameLimiter->EndFrame();
     }
 }
 
@@ -121,10 +218,16 @@ void Game::Shutdown() {
     ImGui_ImplSDL2_Shutdown();
     ImGui::DestroyContext();
     
-    // Cleanup core systems
+    // Cleanup core systems; the journal flushes to disk on the way out
+    m_sessionJournal.reset();
+    m_httpClient.reset();
+    m_jobSystem.reset();
+    m_configWatcher.reset();
+    m_frameLimiter.reset();
     m_audio.reset();
     m_input.reset();
     m_renderer.reset();
+    m_viewport.reset();
     
     // Cleanup SDL
     if (m_glContext) {
@@ -188,6 +291,122 @@ void Game::SetFullscreen(bool fullscreen) {
 void Game::SetVSync(bool vsync) {
     m_vsync = vsync;
     SDL_GL_SetSwapInterval(vsync ? 1 : 0);
+    
+    if (m_frameLimiter) {
+        m_frameLimiter->SetVSync(vsync, GetDisplayRefreshRate());
+    }
+}
+
+void Game::SetTargetFps(int fps) {
+    if (m_frameLimiter) {
+        m_frameLimiter->SetTargetFps(fps);
+    }
+}
+
+void Game::SetLowLatencyMode(bool enabled) {
+    if (m_frameLimiter) {
+        m_frameLimiter->SetLowLatency(enabled);
+    }
+}
+
+int Game::GetDisplayRefreshRate() const {
+    SDL_DisplayMode mode;
+    if (m_window && SDL_GetWindowDisplayMode(m_window, &mode) == 0 && mode.refresh_rate > 0) {
+        return mode.refresh_rate;
+    }
+    return 60;
+}
+
+void Game::SetRenderScale(float scale) {
+    if (!m_viewport) return;
+    
+    m_viewport->SetRenderScale(scale);
+    
+    // Cached layers are stored at the old pixel density
+    if (m_renderer) {
+        m_renderer->InvalidateLayers();
+    }
+}
+
+void Game::SetSimulationRate(int ticksPerSecond) {
+    if (ticksPerSecond <= 0) {
+        std::cerr << "Invalid simulation rate " << ticksPerSecond << ", keeping " << m_physicsFps << std::endl;
+        return;
+    }
+    
+    m_physicsFps = ticksPerSecond;
+    m_fixedDeltaTime = 1.0f / ticksPerSecond;
+    m_accumulator = 0.0;
+}
+
+void Game::LoadConfig() {
+    m_configPath = GameConfig::FindConfigFile();
+    
+    // The binary snapshot lives in the per-user data directory
+    char* prefPath = SDL_GetPrefPath("DesktopSurvivorDash", "DesktopSurvivorDash");
+    if (prefPath) {
+        m_prefPath = prefPath;
+        m_configCachePath = m_prefPath + "game_config.bin";
+        SDL_free(prefPath);
+    }
+    
+    m_config.Load(m_configPath, m_configCachePath);
+    
+    m_screenWidth = m_config.window.width;
+    m_screenHeight = m_config.window.height;
+    m_vsync = m_config.window.vsync;
+    
+#ifndef NDEBUG
+    m_configWatcher = std::make_unique<ConfigWatcher>(m_configPath);
+#endif
+}
+
+void Game::ReloadConfig() {
+    GameConfig reloaded;
+    if (!reloaded.Load(m_configPath, m_configCachePath)) {
+        std::cerr << "Config reload failed, keeping the current settings" << std::endl;
+        return;
+    }
+    
+    const GameConfig::Window previous = m_config.window;
+    m_config = reloaded;
+    std::cout << "Config reloaded" << std::endl;
+    
+    // Window settings only change what actually differs
+    if (m_config.window.vsync != previous.vsync) {
+        SetVSync(m_config.window.vsync);
+    }
+    if (!m_fullscreen && (m_config.window.width != previous.width || m_config.window.height != previous.height)) {
+        m_screenWidth = m_config.window.width;
+        m_screenHeight = m_config.window.height;
+        SDL_SetWindowSize(m_window, m_screenWidth, m_screenHeight);
+    }
+    SDL_SetWindowMinimumSize(m_window, m_config.window.minWidth, m_config.window.minHeight);
+    
+    ApplyConfig();
+}
+
+void Game::ApplyConfig() {
+    SetSimulationRate(m_config.game.physicsFps);
+    SetTargetFps(m_config.game.targetFps);
+    SetRenderScale(m_config.graphics.renderScale);
+    SetFullscreen(m_config.window.fullscreen);
+    
+    if (m_sessionJournal) {
+        ApplyNetworkConfig();
+    }
+}
+
+void Game::ApplyNetworkConfig() {
+    m_sessionJournal->SetBaseUrl(m_config.network.apiBaseUrl);
+    m_sessionJournal->SetTimeout(m_config.network.timeoutMs);
+    
+    WireFormat format = WireFormat::Json;
+    if (!ParseWireFormat(m_config.network.wireFormat, format)) {
+        std::cerr << "Unknown network wire_format '" << m_config.network.wireFormat
+                  << "', using json" << std::endl;
+    }
+    m_sessionJournal->SetWireFormat(format);
 }
 
 bool Game::InitializeSDL() {
@@ -206,19 +425,24 @@ bool Game::InitializeSDL() {
     SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 8);
     
     // Create window
+    Uint32 windowFlags = SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN;
+    if (m_config.window.resizable) {
+        windowFlags |= SDL_WINDOW_RESIZABLE;
+    }
     m_window = SDL_CreateWindow(
-        "Desktop Survivor Dash",
+        m_config.game.title.c_str(),
         SDL_WINDOWPOS_CENTERED,
         SDL_WINDOWPOS_CENTERED,
         m_screenWidth,
         m_screenHeight,
-        SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE
+        windowFlags
     );
     
     if (!m_window) {
         std::cerr << "Window could not be created! SDL Error: " << SDL_GetError() << std::endl;
         return false;
     }
+    SDL_SetWindowMinimumSize(m_window, m_config.window.minWidth, m_config.window.minHeight);
     
     // Try to create OpenGL context
     m_glContext = SDL_GL_CreateContext(m_window);
@@ -237,7 +461,7 @@ bool Game::InitializeSDL() {
         }
     }
     
-    // Enable VSync by default
+    // VSync as configured
     SetVSync(m_vsync);
     
     return true;
@@ -269,27 +493,46 @@ bool Game::InitializeOpenGL() {
 }
 
 void Game::CalculateDeltaTime() {
-    Uint32 currentTime = SDL_GetTicks();
-    m_deltaTime = (currentTime - m_lastFrameTime) / 1000.0f;
-    m_lastFrameTime = currentTime;
+    Uint64 currentCounter = SDL_GetPerformanceCounter();
+    double frameTime = (currentCounter - m_lastFrameCounter) / m_counterFrequency;
+    m_lastFrameCounter = currentCounter;
     
-    // Cap delta time to prevent large jumps
-    if (m_deltaTime > 0.05f) {
-        m_deltaTime = 0.05f;
+    // Cap frame time so a long stall can't spiral into ever more ticks
+    if (frameTime > kMaxFrameTime) {
+        frameTime = kMaxFrameTime;
     }
+    m_deltaTime = static_cast<float>(frameTime);
 }
 
 void Game::UpdateFPS() {
     m_frameCount++;
-    Uint32 currentTime = SDL_GetTicks();
+    Uint64 currentCounter = SDL_GetPerformanceCounter();
+    double elapsed = (currentCounter - m_fpsCounter) / m_counterFrequency;
     
-    if (currentTime - m_fpsTimer >= 1000) {
-        m_fps = m_frameCount * 1000.0f / (currentTime - m_fpsTimer);
+    if (elapsed >= 1.0) {
+        int frames = m_frameCount;
+        m_fps = static_cast<float>(frames / elapsed);
         m_frameCount = 0;
-        m_fpsTimer = currentTime;
+        m_fpsCounter = currentCounter;
+        
+        // Update window title with FPS and frame pacing stats
+        std::string title = m_config.game.title + " - FPS: " + std::to_string((int)m_fps);
+        if (m_frameLimiter) {
+            FrameLimiter::Stats stats = m_frameLimiter->ConsumeStats();
+            char pacing[96];
+            snprintf(pacing, sizeof(pacing), " | frame %.2f ms, jitter %.2f ms, max %.2f ms",
+                     stats.meanMs, stats.jitterMs, stats.maxMs);
+            title += pacing;
+        }
         
-        // Update window title with FPS
-        std::string title = "Desktop Survivor Dash - FPS: " + std::to_string((int)m_fps);
+        // Heap allocations per frame. Steady-state play should sit near 0;
+        // building this title is counted too, once a second.
+        uint64_t allocations = AllocationCounter::GetAllocationCount();
+        char heap[48];
+        snprintf(heap, sizeof(heap), " | %.1f allocs/frame",
+                 static_cast<double>(allocations - m_fpsAllocationCount) / frames);
+        title += heap;
+        m_fpsAllocationCount = allocations;
         SDL_SetWindowTitle(m_window, title.c_str());
     }
 }
@@ -307,7 +550,12 @@ void Game::HandleEvents() {
             if (event.window.event == SDL_WINDOWEVENT_RESIZED) {
                 m_screenWidth = event.window.data1;
                 m_screenHeight = event.window.data2;
-                glViewport(0, 0, m_screenWidth, m_screenHeight);
+                m_viewport->SetWindowSize(m_screenWidth, m_screenHeight);
+                
+                // Cached static layers were rendered for the old size
+                if (m_renderer) {
+                    m_renderer->InvalidateLayers();
+                }
             }
         }
         
@@ -324,18 +572,40 @@ void Game::HandleEvents() {
 }
 
 void Game::Update(float deltaTime) {
-    // Update input system
-    if (m_input) {
-        m_input->Update();
-    }
-    
     // Update current state
     if (!m_states.empty()) {
         m_states.top()->Update(deltaTime);
     }
 }
 
+void Game::Simulate() {
+    // Run as many fixed ticks as the elapsed time covers; the remainder
+    // carries over and becomes the interpolation factor for rendering
+    m_accumulator += m_deltaTime;
+    while (m_accumulator >= m_fixedDeltaTime && m_running && !m_states.empty()) {
+        Update(m_fixedDeltaTime);
+        m_accumulator -= m_fixedDeltaTime;
+    }
+    m_interpolationAlpha = static_cast<float>(m_accumulator / m_fixedDeltaTime);
+    
+    if (!m_states.empty()) {
+        m_states.top()->ProduceRenderSnapshot();
+    }
+}
+
+void Game::SimulateJob(void* data, size_t /*begin*/, size_t /*end*/) {
+    static_cast<Game*>(data)->Simulate();
+}
+
 void Game::Render() {
+    RenderScene();
+    RenderOverlay();
+}
+
+void Game::RenderScene() {
+    // Bind the scene target for this frame's viewport and render scale
+    m_renderer->BeginFrame(*m_viewport);
+    
     // Clear screen
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     
@@ -344,6 +614,11 @@ void Game::Render() {
         m_states.top()->Render(m_renderer.get());
     }
     
+    // Submit the frame's batched geometry (and upscale it) before ImGui draws on top
+    m_renderer->EndFrame();
+}
+
+void Game::RenderOverlay() {
     // Start ImGui frame
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplSDL2_NewFrame();
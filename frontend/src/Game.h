@@ -2,8 +2,11 @@
 
 #include <memory>
 #include <stack>
+#include <cstddef>
 #include <SDL2/SDL.h>
 #include <GL/glew.h>
+#include <string>
+#include "GameConfig.h"
 
 // Forward declarations for SDL types
 struct SDL_Window;
@@ -15,6 +18,12 @@ class GameState;
 class Renderer;
 class Input;
 class Audio;
+class Viewport;
+class FrameLimiter;
+class JobSystem;
+class HttpClient;
+class SessionJournal;
+class ConfigWatcher;
 
 class Game {
 public:
@@ -37,6 +46,15 @@ public:
     Renderer* GetRenderer() const { return m_renderer.get(); }
     Input* GetInput() const { return m_input.get(); }
     Audio* GetAudio() const { return m_audio.get(); }
+    Viewport* GetViewport() const { return m_viewport.get(); }
+    JobSystem* GetJobSystem() const { return m_jobSystem.get(); }
+    HttpClient* GetHttpClient() const { return m_httpClient.get(); }
+    SessionJournal* GetSessionJournal() const { return m_sessionJournal.get(); }
+    
+    // Tunables from shared/configs/game_config.json. Reloaded in place when
+    // the file changes (debug builds); states should read values where they
+    // use them rather than caching them.
+    const GameConfig& GetConfig() const { return m_config; }
     
     bool IsRunning() const { return m_running; }
     void SetRunning(bool running) { m_running = running; }
@@ -48,8 +66,33 @@ public:
     
     void SetFullscreen(bool fullscreen);
     void SetVSync(bool vsync);
+    void SetRenderScale(float scale);
+
+    // Fixed-timestep simulation: states are updated in steps of
+    // GetFixedDeltaTime() and render between the last two ticks using
+    // GetInterpolationAlpha() (0 = previous tick, 1 = latest tick)
+    void SetSimulationRate(int ticksPerSecond);
+    
+    // Frame pacing: target_fps caps the loop when VSync is off; low latency
+    // mode delays input polling so the frame finishes just before the swap
+    void SetTargetFps(int fps);
+    void SetLowLatencyMode(bool enabled);
+    
+    // Pipelined mode: for states that opt in (GameState::UsesRenderSnapshot)
+    // the next frame is simulated on a worker while this one is drawn
+    void SetPipelinedMode(bool enabled) { m_pipelined = enabled; }
+    bool IsPipelinedMode() const { return m_pipelined; }
+    float GetFixedDeltaTime() const { return m_fixedDeltaTime; }
+    float GetInterpolationAlpha() const { return m_interpolationAlpha; }
 
 private:
+    // Configuration (first: other members are initialized from it)
+    GameConfig m_config;
+    std::string m_configPath;
+    std::string m_configCachePath;
+    std::string m_prefPath;         // Per-user data directory, empty if unavailable
+    std::unique_ptr<ConfigWatcher> m_configWatcher;
+    
     // SDL and OpenGL
     SDL_Window* m_window;
     SDL_GLContext m_glContext;
@@ -58,6 +101,11 @@ private:
     std::unique_ptr<Renderer> m_renderer;
     std::unique_ptr<Input> m_input;
     std::unique_ptr<Audio> m_audio;
+    std::unique_ptr<Viewport> m_viewport;
+    std::unique_ptr<FrameLimiter> m_frameLimiter;
+    std::unique_ptr<JobSystem> m_jobSystem;
+    std::unique_ptr<HttpClient> m_httpClient;
+    std::unique_ptr<SessionJournal> m_sessionJournal;
     
     // Game state stack
     std::stack<std::unique_ptr<GameState>> m_states;
@@ -68,22 +116,40 @@ private:
     bool m_fullscreen;
     bool m_vsync;
     bool m_running;
+    bool m_pipelined;
     
-    // Frame timing
-    Uint32 m_lastFrameTime;
+    // Frame timing (performance counter ticks)
+    Uint64 m_lastFrameCounter;
+    double m_counterFrequency;
     float m_deltaTime;
     
+    // Fixed-timestep simulation
+    int m_physicsFps;
+    float m_fixedDeltaTime;
+    double m_accumulator;
+    float m_interpolationAlpha;
+    
     // FPS tracking
     int m_frameCount;
-    Uint32 m_fpsTimer;
+    Uint64 m_fpsCounter;
     float m_fps;
+    uint64_t m_fpsAllocationCount;
 
     // Private methods
+    void LoadConfig();
+    void ReloadConfig();
+    void ApplyConfig();
+    void ApplyNetworkConfig();
     bool InitializeSDL();
     bool InitializeOpenGL();
     void CalculateDeltaTime();
     void UpdateFPS();
+    int GetDisplayRefreshRate() const;
     void HandleEvents();
     void Update(float deltaTime);
+    void Simulate();
+    static void SimulateJob(void* data, size_t begin, size_t end);
     void Render();
+    void RenderScene();
+    void RenderOverlay();
 }; 
\ No newline at end of file
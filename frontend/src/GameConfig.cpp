@@ -0,0 +1,407 @@
+#include "GameConfig.h"
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <sys/stat.h>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <climits>
+#endif
+
+namespace {
+// Relative to the working directory: repo root, frontend/ or frontend/build/
+const char* const kConfigPaths[] = {
+    "shared/configs/game_config.json",
+    "../shared/configs/game_config.json",
+    "../../shared/configs/game_config.json",
+};
+
+// Binary snapshot header. Bump kCacheVersion whenever VisitFields changes.
+constexpr uint32_t kCacheMagic = 0x43475344;    // "DSGC"
+constexpr uint32_t kCacheVersion = 2;
+
+// How often the polling watcher looks at the file
+constexpr std::time_t kPollIntervalSeconds = 1;
+
+// The one list of fields: block, key, member and valid range. Drives the
+// JSON reader and both directions of the binary cache, so they can't drift
+// apart.
+template <typename Visitor>
+void VisitFields(GameConfig& c, Visitor& v) {
+    v("game", "title", c.game.title);
+    v("game", "target_fps", c.game.targetFps, 1, 1000);
+    v("game", "physics_fps", c.game.physicsFps, 1, 1000);
+
+    v("window", "width", c.window.width, 320, 16384);
+    v("window", "height", c.window.height, 240, 16384);
+    v("window", "fullscreen", c.window.fullscreen);
+    v("window", "vsync", c.window.vsync);
+    v("window", "resizable", c.window.resizable);
+    v("window", "min_width", c.window.minWidth, 320, 16384);
+    v("window", "min_height", c.window.minHeight, 240, 16384);
+
+    v("graphics", "render_scale", c.graphics.renderScale, 0.25f, 4.0f);
+
+    v("player", "starting_lives", c.player.startingLives, 1, 99);
+    v("player", "collision_radius", c.player.collisionRadius, 1.0f, 200.0f);
+
+    v("enemies", "spawn_rate_multiplier", c.enemies.spawnRateMultiplier, 0.01f, 100.0f);
+    v("enemies", "speed_multiplier", c.enemies.speedMultiplier, 0.01f, 100.0f);
+    v("enemies", "max_enemies", c.enemies.maxEnemies, 1, 1000000);
+    v("enemies", "min_speed", c.enemies.minSpeed, 0.0f, 10000.0f);
+    v("enemies", "max_speed", c.enemies.maxSpeed, 0.0f, 10000.0f);
+    v("enemies", "steering_acceleration", c.enemies.steeringAcceleration, 0.0f, 10000.0f);
+
+    v("power_ups", "interval", c.powerUps.interval, 0.1f, 3600.0f);
+    v("power_ups", "max_active", c.powerUps.maxActive, 0, 10000);
+    v("power_ups", "radius", c.powerUps.radius, 1.0f, 500.0f);
+    v("power_ups", "score", c.powerUps.score, 0, 1000000);
+
+    v("waves", "base_duration", c.waves.baseDuration, 1.0f, 3600.0f);
+    v("waves", "difficulty_scaling", c.waves.difficultyScaling, 0.1f, 10.0f);
+    v("waves", "boss_every", c.waves.bossEvery, 0, 1000);
+    v("waves", "enemy_count_multiplier", c.waves.enemyCountMultiplier, 0.1f, 10.0f);
+
+    v("network", "api_base_url", c.network.apiBaseUrl);
+    v("network", "timeout", c.network.timeoutMs, 100, 600000);
+    v("network", "wire_format", c.network.wireFormat);
+}
+
+class JsonReader {
+public:
+    explicit JsonReader(const nlohmann::json& root) : m_root(root) {}
+
+    void operator()(const char* block, const char* key, std::string& value) {
+        const nlohmann::json* field = Find(block, key);
+        if (!field) return;
+        if (field->is_string()) {
+            value = field->get<std::string>();
+        } else {
+            Warn(block, key, "expected a string");
+        }
+    }
+
+    void operator()(const char* block, const char* key, bool& value) {
+        const nlohmann::json* field = Find(block, key);
+        if (!field) return;
+        if (field->is_boolean()) {
+            value = field->get<bool>();
+        } else {
+            Warn(block, key, "expected true or false");
+        }
+    }
+
+    void operator()(const char* block, const char* key, int& value, int min, int max) {
+        const nlohmann::json* field = Find(block, key);
+        if (!field) return;
+        if (!field->is_number_integer()) {
+            Warn(block, key, "expected an integer");
+            return;
+        }
+        long long read = field->get<long long>();
+        if (read < min || read > max) {
+            Warn(block, key, "out of range");
+            return;
+        }
+        value = static_cast<int>(read);
+    }
+
+    void operator()(const char* block, const char* key, float& value, float min, float max) {
+        const nlohmann::json* field = Find(block, key);
+        if (!field) return;
+        if (!field->is_number()) {
+            Warn(block, key, "expected a number");
+            return;
+        }
+        double read = field->get<double>();
+        if (!(read >= min && read <= max)) {
+            Warn(block, key, "out of range");
+            return;
+        }
+        value = static_cast<float>(read);
+    }
+
+private:
+    const nlohmann::json& m_root;
+
+    // Missing keys are normal (the default applies) and not reported
+    const nlohmann::json* Find(const char* block, const char* key) const {
+        auto blockIt = m_root.find(block);
+        if (blockIt == m_root.end() || !blockIt->is_object()) return nullptr;
+        auto keyIt = blockIt->find(key);
+        return keyIt == blockIt->end() ? nullptr : &*keyIt;
+    }
+
+    static void Warn(const char* block, const char* key, const char* problem) {
+        std::cerr << "Config " << block << "." << key << ": " << problem << ", using default" << std::endl;
+    }
+};
+
+class CacheWriter {
+public:
+    template <typename T>
+    void Pod(const T& value) {
+        m_data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void operator()(const char*, const char*, std::string& value) {
+        Pod(static_cast<uint32_t>(value.size()));
+        m_data.append(value);
+    }
+    void operator()(const char*, const char*, bool& value) { Pod(static_cast<uint8_t>(value)); }
+    void operator()(const char*, const char*, int& value, int, int) { Pod(value); }
+    void operator()(const char*, const char*, float& value, float, float) { Pod(value); }
+
+    const std::string& GetData() const { return m_data; }
+
+private:
+    std::string m_data;
+};
+
+class CacheReader {
+public:
+    explicit CacheReader(const std::string& data) : m_data(data), m_offset(0), m_ok(true) {}
+
+    template <typename T>
+    bool Pod(T& value) {
+        if (!m_ok || m_data.size() - m_offset < sizeof(T)) {
+            m_ok = false;
+            return false;
+        }
+        std::memcpy(&value, m_data.data() + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return true;
+    }
+
+    void operator()(const char*, const char*, std::string& value) {
+        uint32_t length = 0;
+        if (!Pod(length) || m_data.size() - m_offset < length) {
+            m_ok = false;
+            return;
+        }
+        value.assign(m_data, m_offset, length);
+        m_offset += length;
+    }
+    void operator()(const char*, const char*, bool& value) {
+        uint8_t read = 0;
+        if (Pod(read)) value = read != 0;
+    }
+    void operator()(const char*, const char*, int& value, int, int) { Pod(value); }
+    void operator()(const char*, const char*, float& value, float, float) { Pod(value); }
+
+    // Everything read and nothing left over
+    bool Succeeded() const { return m_ok && m_offset == m_data.size(); }
+
+private:
+    const std::string& m_data;
+    size_t m_offset;
+    bool m_ok;
+};
+
+bool StatFile(const std::string& path, long long& size, long long& modified) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) return false;
+    size = static_cast<long long>(info.st_size);
+    modified = static_cast<long long>(info.st_mtime);
+    return true;
+}
+}
+
+bool GameConfig::Load(const std::string& jsonPath, const std::string& cachePath) {
+    long long sourceSize = 0;
+    long long sourceTime = 0;
+    if (!StatFile(jsonPath, sourceSize, sourceTime)) {
+        std::cerr << "Config file " << jsonPath << " not found, using defaults" << std::endl;
+        return false;
+    }
+
+    if (!cachePath.empty() && ReadCache(cachePath, sourceSize, sourceTime)) {
+        std::cout << "Loaded config snapshot " << cachePath << std::endl;
+        return true;
+    }
+
+    if (!ParseJson(jsonPath)) {
+        return false;
+    }
+    std::cout << "Loaded config " << jsonPath << std::endl;
+
+    if (!cachePath.empty()) {
+        WriteCache(cachePath, sourceSize, sourceTime);
+    }
+    return true;
+}
+
+std::string GameConfig::FindConfigFile() {
+    for (const char* path : kConfigPaths) {
+        std::ifstream file(path);
+        if (file) return path;
+    }
+    return kConfigPaths[0];
+}
+
+bool GameConfig::ParseJson(const std::string& jsonPath) {
+    std::ifstream file(jsonPath);
+    if (!file) {
+        std::cerr << "Failed to open config " << jsonPath << std::endl;
+        return false;
+    }
+
+    nlohmann::json root;
+    try {
+        root = nlohmann::json::parse(file);
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to parse config " << jsonPath << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    // Parse into a fresh copy so a bad file never leaves half-applied values
+    GameConfig parsed;
+    JsonReader reader(root);
+    VisitFields(parsed, reader);
+
+    // Cross-field rules
+    parsed.window.minWidth = std::min(parsed.window.minWidth, parsed.window.width);
+    parsed.window.minHeight = std::min(parsed.window.minHeight, parsed.window.height);
+    if (parsed.enemies.maxSpeed < parsed.enemies.minSpeed) {
+        std::cerr << "Config enemies.max_speed is below min_speed, swapping them" << std::endl;
+        std::swap(parsed.enemies.minSpeed, parsed.enemies.maxSpeed);
+    }
+
+    *this = parsed;
+    return true;
+}
+
+bool GameConfig::ReadCache(const std::string& cachePath, long long sourceSize, long long sourceTime) {
+    std::ifstream file(cachePath, std::ios::binary);
+    if (!file) return false;
+
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    std::string data = contents.str();
+
+    CacheReader reader(data);
+    uint32_t magic = 0, version = 0;
+    long long cachedSize = 0, cachedTime = 0;
+    reader.Pod(magic);
+    reader.Pod(version);
+    reader.Pod(cachedSize);
+    reader.Pod(cachedTime);
+    if (magic != kCacheMagic || version != kCacheVersion || cachedSize != sourceSize || cachedTime != sourceTime) {
+        return false;
+    }
+
+    GameConfig cached;
+    VisitFields(cached, reader);
+    if (!reader.Succeeded()) {
+        std::cerr << "Config snapshot " << cachePath << " is corrupt, reparsing" << std::endl;
+        return false;
+    }
+    *this = cached;
+    return true;
+}
+
+void GameConfig::WriteCache(const std::string& cachePath, long long sourceSize, long long sourceTime) const {
+    CacheWriter writer;
+    writer.Pod(kCacheMagic);
+    writer.Pod(kCacheVersion);
+    writer.Pod(sourceSize);
+    writer.Pod(sourceTime);
+
+    GameConfig copy = *this;
+    VisitFields(copy, writer);
+
+    // Write then rename, so a crash mid-write can't leave a torn snapshot
+    std::string temporaryPath = cachePath + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "Failed to write config snapshot " << cachePath << std::endl;
+            return;
+        }
+        file.write(writer.GetData().data(), static_cast<std::streamsize>(writer.GetData().size()));
+    }
+    if (std::rename(temporaryPath.c_str(), cachePath.c_str()) != 0) {
+        std::cerr << "Failed to replace config snapshot " << cachePath << std::endl;
+        std::remove(temporaryPath.c_str());
+    }
+}
+
+ConfigWatcher::ConfigWatcher(const std::string& path)
+    : m_path(path)
+    , m_inotifyFd(-1)
+    , m_watch(-1)
+    , m_lastModified(0)
+    , m_lastSize(0)
+    , m_lastCheck(0)
+{
+#if defined(__linux__)
+    // Watch the directory: editors often save by writing a new file and
+    // renaming it over the old one, which a file watch would miss
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd >= 0) {
+        size_t slash = m_path.find_last_of('/');
+        std::string directory = slash == std::string::npos ? "." : m_path.substr(0, slash);
+        m_watch = inotify_add_watch(m_inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (m_watch < 0) {
+            close(m_inotifyFd);
+            m_inotifyFd = -1;
+        }
+    }
+#endif
+
+    long long modified = 0;
+    StatFile(m_path, m_lastSize, modified);
+    m_lastModified = static_cast<std::time_t>(modified);
+    std::cout << "Watching " << m_path << " for changes" << (m_inotifyFd >= 0 ? " (inotify)" : "") << std::endl;
+}
+
+ConfigWatcher::~ConfigWatcher() {
+#if defined(__linux__)
+    if (m_inotifyFd >= 0) {
+        close(m_inotifyFd);
+    }
+#endif
+}
+
+bool ConfigWatcher::Poll() {
+#if defined(__linux__)
+    if (m_inotifyFd >= 0) {
+        size_t slash = m_path.find_last_of('/');
+        std::string name = slash == std::string::npos ? m_path : m_path.substr(slash + 1);
+
+        bool changed = false;
+        alignas(inotify_event) char buffer[sizeof(inotify_event) + NAME_MAX + 1];
+        ssize_t length;
+        while ((length = read(m_inotifyFd, buffer, sizeof(buffer))) > 0) {
+            for (ssize_t offset = 0; offset < length; ) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                if (event->len > 0 && name == event->name) {
+                    changed = true;
+                }
+                offset += sizeof(inotify_event) + event->len;
+            }
+        }
+        return changed;
+    }
+#endif
+
+    // Fallback: look at the modification time once a second
+    std::time_t now = std::time(nullptr);
+    if (now - m_lastCheck < kPollIntervalSeconds) return false;
+    m_lastCheck = now;
+
+    long long size = 0, modified = 0;
+    if (!StatFile(m_path, size, modified)) return false;
+    if (static_cast<std::time_t>(modified) == m_lastModified && size == m_lastSize) return false;
+
+    m_lastModified = static_cast<std::time_t>(modified);
+    m_lastSize = size;
+    return true;
+}
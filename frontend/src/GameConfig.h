@@ -0,0 +1,99 @@
+#pragma once
+
+#include <string>
+#include <ctime>
+
+// Typed view of shared/configs/game_config.json.
+//
+// Parsed once at startup; everything else reads plain fields. Every field
+// has a default and a valid range, so a missing key, a wrong type or an
+// out-of-range value logs a warning and keeps the default instead of
+// failing startup. Only the blocks and keys the game uses are read.
+struct GameConfig {
+    struct Game {
+        std::string title = "Desktop Survivor Dash";
+        int targetFps = 60;
+        int physicsFps = 120;
+    } game;
+
+    struct Window {
+        int width = 1280;
+        int height = 720;
+        bool fullscreen = false;
+        bool vsync = true;
+        bool resizable = true;
+        int minWidth = 800;
+        int minHeight = 600;
+    } window;
+
+    struct Graphics {
+        float renderScale = 1.0f;
+    } graphics;
+
+    struct Player {
+        int startingLives = 3;
+        float collisionRadius = 8.0f;
+    } player;
+
+    struct Enemies {
+        float spawnRateMultiplier = 1.0f;
+        float speedMultiplier = 1.0f;
+        int maxEnemies = 50;
+        float minSpeed = 50.0f;             // Units per second, before multipliers
+        float maxSpeed = 100.0f;
+        float steeringAcceleration = 20.0f;
+    } enemies;
+
+    struct PowerUps {
+        float interval = 5.0f;              // Seconds between spawns
+        int maxActive = 32;
+        float radius = 20.0f;
+        int score = 50;
+    } powerUps;
+
+    struct Waves {
+        float baseDuration = 30.0f;
+        float difficultyScaling = 1.15f;
+        int bossEvery = 5;
+        float enemyCountMultiplier = 1.2f;
+    } waves;
+
+    struct Network {
+        std::string apiBaseUrl = "http://localhost:3000";
+        int timeoutMs = 30000;
+        std::string wireFormat = "json";    // Game telemetry bodies: json, msgpack or cbor
+    } network;
+
+    // Reads and validates 'jsonPath'. With a cachePath, a binary snapshot
+    // of the result is kept there and used instead of parsing as long as
+    // the JSON file's size and modification time are unchanged. Returns
+    // false (and leaves defaults for everything) if the file can't be read.
+    bool Load(const std::string& jsonPath, const std::string& cachePath = "");
+
+    // Locates game_config.json relative to the working directory
+    static std::string FindConfigFile();
+
+private:
+    bool ParseJson(const std::string& jsonPath);
+    bool ReadCache(const std::string& cachePath, long long sourceSize, long long sourceTime);
+    void WriteCache(const std::string& cachePath, long long sourceSize, long long sourceTime) const;
+};
+
+// Reports changes to the config file. Uses inotify on Linux and polls the
+// modification time elsewhere; meant for development builds.
+class ConfigWatcher {
+public:
+    explicit ConfigWatcher(const std::string& path);
+    ~ConfigWatcher();
+
+    // Non-blocking; true once per change
+    bool Poll();
+
+private:
+    std::string m_path;
+    int m_inotifyFd;
+    int m_watch;
+    std::time_t m_lastModified;
+    long long m_lastSize;
+    std::time_t m_lastCheck;
+};
@@ -19,6 +19,14 @@ public:
     virtual void Update(float deltaTime) = 0;
     virtual void Render(Renderer* renderer) = 0;
     virtual void RenderUI() = 0;
+    
+    // Pipelined mode (opt-in). A state that returns true here has Update()
+    // and ProduceRenderSnapshot() run on a worker thread while the main
+    // thread draws the previous frame, so Render() must only read what the
+    // last snapshot captured. RenderUI() runs after the two threads join.
+    virtual bool UsesRenderSnapshot() const { return false; }
+    // Called once per frame after the simulation ticks
+    virtual void ProduceRenderSnapshot() {}
 
 protected:
     Game* m_game;
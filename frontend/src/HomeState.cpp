@@ -3,6 +3,7 @@
 #include "Game.h"
 #include "Renderer.h"
 #include "NetworkManager.h"
+#include <nlohmann/json.hpp>
 #include <SDL2/SDL.h>
 #include <GL/glew.h>
 #include <imgui.h>
@@ -11,6 +12,13 @@
 #include <sstream>
 #include <iomanip>
 
+using json = nlohmann::json;
+
+namespace {
+// Rows requested per leaderboard; the server caps it at 100 (50 for recent)
+constexpr int kLeaderboardLimit = 50;
+}
+
 HomeState::HomeState(Game* game) 
     : GameState(game)
     , m_currentMode(UIMode::MAIN_MENU)
@@ -21,14 +29,20 @@ HomeState::HomeState(Game* game)
     , m_showProfile(false)
     , m_selectedLeaderboardTab("scores")
     , m_leaderboardLoading(false)
+    , m_leaderboardsPending(0)
     , m_selectedSkillCategory("combat")
     , m_skillsLoading(false)
     , m_userLevel(1)
     , m_volume(0.8f)
     , m_fullscreen(false)
     , m_selectedGraphicsQuality("medium")
-    , m_networkManager(std::make_unique<NetworkManager>())
+    , m_networkManager(std::make_unique<NetworkManager>(game->GetHttpClient()))
 {
+    // Server address and timeout from the config
+    const GameConfig& config = m_game->GetConfig();
+    m_networkManager->SetBaseUrl(config.network.apiBaseUrl);
+    m_networkManager->SetTimeout(config.network.timeoutMs);
+    
     // Initialize with starting values - will be updated from real user data
     m_userCurrency.skillPoints = 0;
     m_userCurrency.coins = 50;
@@ -51,10 +65,8 @@ void HomeState::OnEnter() {
     m_skills.clear();
     m_skillsByCategory.clear();
     
-    // Load user's current stats from database
+    // All of these are in flight at once; the screen fills in as they land
     LoadUserProgress();
-    
-    // Load real data from network
     LoadLeaderboards();
     LoadSkills();
 }
@@ -65,6 +77,7 @@ void HomeState::OnExit() {
 
 void HomeState::SetAuthToken(const std::string& token) {
     m_authToken = token;
+    m_networkManager->SetAuthToken(token);
     std::cout << "Auth token set in HomeState" << std::endl;
 }
 
@@ -89,12 +102,17 @@ void HomeState::HandleEvent(const SDL_Event& event) {
 }
 
 void HomeState::Update(float deltaTime) {
-    m_networkManager->Update();
 }
 
 void HomeState::Render(Renderer* renderer) {
-    renderer->DrawRect(0, 0, 1280, 720, 0.1f, 0.1f, 0.15f, 1.0f);
-    renderer->DrawRect(0, 680, 1280, 40, 0.2f, 0.2f, 0.3f, 0.9f);
+    float worldWidth = renderer->GetWorldWidth();
+    float worldHeight = renderer->GetWorldHeight();
+    if (renderer->BeginLayer(RenderLayer::HomeBackdrop, 0, 0, worldWidth, worldHeight)) {
+        renderer->DrawRect(0, 0, worldWidth, worldHeight, 0.1f, 0.1f, 0.15f, 1.0f);
+        renderer->DrawRect(0, worldHeight - 40, worldWidth, 40, 0.2f, 0.2f, 0.3f, 0.9f);
+        renderer->EndLayer();
+    }
+    renderer->DrawLayer(RenderLayer::HomeBackdrop);
 }
 
 void HomeState::RenderUI() {
@@ -314,20 +332,61 @@ void HomeState::LoadLeaderboards() {
     m_survivalLeaderboard.clear(); 
     m_killsLeaderboard.clear();
     m_recentLeaderboard.clear();
+    m_leaderboardError.clear();
     
-    // TODO: Load real leaderboard data from network
-    // For now, keep empty - no sample data
-    std::cout << "Leaderboards cleared - no sample data loaded" << std::endl;
+    // Each query fills its own table when it lands
+    auto storeIn = [this](std::vector<LeaderboardEntry>& target, const char* name) -> LeaderboardCallback {
+        return [this, &target, name](bool success, const std::vector<LeaderboardEntry>& entries, const std::string& error) {
+            if (success) {
+                target = entries;
+            } else {
+                m_leaderboardError = error;
+                std::cout << "Failed to load " << name << " leaderboard: " << error << std::endl;
+            }
+            if (--m_leaderboardsPending == 0) {
+                m_leaderboardLoading = false;
+            }
+        };
+    };
+    
+    m_leaderboardLoading = true;
+    m_leaderboardsPending += 4;
+    m_networkManager->GetScoreLeaderboard("all", kLeaderboardLimit, storeIn(m_scoreLeaderboard, "score"));
+    m_networkManager->GetSurvivalLeaderboard(kLeaderboardLimit, storeIn(m_survivalLeaderboard, "survival"));
+    m_networkManager->GetKillsLeaderboard(kLeaderboardLimit, storeIn(m_killsLeaderboard, "kills"));
+    m_networkManager->GetRecentLeaderboard(kLeaderboardLimit, storeIn(m_recentLeaderboard, "recent"));
 }
 
 void HomeState::LoadSkills() {
     // Clear any existing data first
     m_skills.clear();
     m_skillsByCategory.clear();
+    m_skillsError.clear();
+    
+    if (m_authToken.empty()) {
+        std::cout << "Not signed in - skills unavailable" << std::endl;
+        return;
+    }
     
-    // TODO: Load real skills data from network  
-    // For now, keep empty - no sample data
-    std::cout << "Skills cleared - no sample data loaded" << std::endl;
+    m_skillsLoading = true;
+    m_networkManager->GetUserSkills([this](bool success, const std::vector<Skill>& skills,
+                                           const UserCurrency& currency, int userLevel, const std::string& error) {
+        m_skillsLoading = false;
+        if (!success) {
+            m_skillsError = error;
+            std::cout << "Failed to load skills: " << error << std::endl;
+            return;
+        }
+        
+        m_skills = skills;
+        m_skillsByCategory.clear();
+        for (Skill& skill : m_skills) {
+            m_skillsByCategory[skill.category].push_back(&skill);
+        }
+        m_userCurrency = currency;
+        m_userLevel = userLevel;
+        std::cout << "Loaded " << m_skills.size() << " skills" << std::endl;
+    });
 }
 
 void HomeState::UpgradeSkill(const std::string& skillId) {
@@ -390,8 +449,8 @@ void HomeState::ShowNotification(const std::string& message, float duration) {
 }
 
 void HomeState::LoadUserProgress() {
-    if (!m_networkManager) {
-        std::cout << "No network manager available - using default values" << std::endl;
+    if (m_authToken.empty()) {
+        std::cout << "Not signed in - using default values" << std::endl;
         m_userLevel = 1;
         m_userCurrency.skillPoints = 0;
         m_userCurrency.coins = 50;
@@ -404,13 +463,12 @@ void HomeState::LoadUserProgress() {
     m_networkManager->GetUserStats([this](const HttpResponse& response) {
         if (response.success) {
             try {
-                // Parse user stats from response
-                // For now, simulate loading saved progress
+                json responseData = json::parse(response.data);
+                const json& stats = responseData.at("stats");
+                m_userLevel = stats.value("level", m_userLevel);
+                m_userCurrency.skillPoints = stats.value("skillPoints", m_userCurrency.skillPoints);
+                m_userCurrency.coins = stats.value("coins", m_userCurrency.coins);
                 std::cout << "User progress loaded successfully!" << std::endl;
-                // TODO: Parse actual JSON response and update:
-                // m_userLevel = parsed.level;
-                // m_userCurrency.skillPoints = parsed.skill_points;
-                // m_userCurrency.coins = parsed.coins;
                 
                 std::cout << "Current stats:" << std::endl;
                 std::cout << "  Level: " << m_userLevel << std::endl;
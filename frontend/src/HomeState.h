@@ -92,6 +92,7 @@ private:
     std::vector<LeaderboardEntry> m_recentLeaderboard;
     std::string m_selectedLeaderboardTab;
     bool m_leaderboardLoading;
+    int m_leaderboardsPending;          // Queries still in flight
     std::string m_leaderboardError;
     
     // Skills data
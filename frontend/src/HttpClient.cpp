@@ -0,0 +1,336 @@
+#include "HttpClient.h"
+#include <curl/curl.h>
+#include <iostream>
+#include <memory>
+#include <chrono>
+
+namespace {
+// Connections kept open to the API server between requests
+constexpr long kMaxHostConnections = 6;
+constexpr long kMaxCachedConnections = 16;
+
+// Worker sleep while idle; Send() wakes it early
+constexpr int kIdleWaitMs = 1000;
+// Retry interval while the completion queue is full
+constexpr int kBackedUpWaitMs = 5;
+
+void SetError(HttpResponse& response, const char* error) {
+    response.success = false;
+    response.statusCode = 0;
+    response.error = error;
+}
+
+size_t AppendBody(char* contents, size_t size, size_t nmemb, void* userp) {
+    size_t length = size * nmemb;
+    static_cast<std::string*>(userp)->append(contents, length);
+    return length;
+}
+}
+
+// One in-flight request. Easy handles are reused for later requests.
+struct HttpClient::Transfer {
+    HttpRequestId id = 0;
+    CURL* easy = nullptr;
+    curl_slist* headers = nullptr;
+    HttpRequest request;
+    Receiver receiver;
+    std::string response;
+};
+
+HttpClient::HttpClient()
+    : m_multi(nullptr)
+    , m_running(false)
+    , m_pending(0)
+    , m_nextId(0)
+{
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+}
+
+HttpClient::~HttpClient() {
+    Shutdown();
+    curl_global_cleanup();
+}
+
+bool HttpClient::Initialize() {
+    if (m_running) return true;
+
+    CURLM* multi = curl_multi_init();
+    if (!multi) {
+        std::cerr << "Failed to create HTTP multi handle" << std::endl;
+        return false;
+    }
+    curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, kMaxHostConnections);
+    curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, kMaxCachedConnections);
+    m_multi = multi;
+
+    m_running = true;
+    try {
+        m_worker = std::thread(&HttpClient::WorkerLoop, this);
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to start HTTP worker: " << e.what() << std::endl;
+        m_running = false;
+        curl_multi_cleanup(multi);
+        m_multi = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void HttpClient::Shutdown() {
+    if (!m_multi) return;
+
+    m_running = false;
+    curl_multi_wakeup(static_cast<CURLM*>(m_multi));
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+    curl_multi_cleanup(static_cast<CURLM*>(m_multi));
+    m_multi = nullptr;
+
+    // Callbacks of unfinished requests are dropped along with their owners
+    std::lock_guard<std::mutex> lock(m_requestMutex);
+    m_requests.clear();
+    m_cancellations.clear();
+}
+
+HttpRequestId HttpClient::Send(HttpRequest request, HttpCallback callback, std::weak_ptr<void> owner) {
+    Receiver receiver;
+    receiver.callback = std::move(callback);
+    receiver.owner = std::move(owner);
+    receiver.hasOwner = true;
+    return Enqueue(std::move(request), std::move(receiver));
+}
+
+HttpRequestId HttpClient::Send(HttpRequest request, HttpCallback callback) {
+    Receiver receiver;
+    receiver.callback = std::move(callback);
+    return Enqueue(std::move(request), std::move(receiver));
+}
+
+HttpRequestId HttpClient::Enqueue(HttpRequest request, Receiver receiver) {
+    m_pending++;
+    HttpRequestId id = ++m_nextId;
+
+    const char* error = nullptr;
+    if (!m_running) {
+        error = "HTTP client not running";
+    } else {
+        std::lock_guard<std::mutex> lock(m_requestMutex);
+        if (m_requests.size() >= kMaxQueuedRequests) {
+            error = "Too many pending requests";
+        } else {
+            m_requests.push_back({ id, std::move(request), std::move(receiver) });
+        }
+    }
+
+    if (error) {
+        Completion completion;
+        completion.receiver = std::move(receiver);
+        SetError(completion.response, error);
+        m_rejected.push_back(std::move(completion));
+        return 0;
+    }
+
+    curl_multi_wakeup(static_cast<CURLM*>(m_multi));
+    return id;
+}
+
+void HttpClient::Cancel(HttpRequestId id) {
+    if (id == 0 || !m_running) return;
+
+    std::lock_guard<std::mutex> lock(m_requestMutex);
+    for (auto it = m_requests.begin(); it != m_requests.end(); ++it) {
+        if (it->id == id) {
+            // The worker hasn't seen it yet; answer it here
+            Completion completion;
+            completion.receiver = std::move(it->receiver);
+            SetError(completion.response, "Cancelled");
+            m_rejected.push_back(std::move(completion));
+            m_requests.erase(it);
+            return;
+        }
+    }
+
+    m_cancellations.push_back(id);
+    curl_multi_wakeup(static_cast<CURLM*>(m_multi));
+}
+
+void HttpClient::Dispatch(double budgetSeconds) {
+    auto start = std::chrono::steady_clock::now();
+    auto budget = std::chrono::duration<double>(budgetSeconds);
+
+    Completion completion;
+    for (int dispatched = 0; ; ++dispatched) {
+        if (dispatched > 0 && std::chrono::steady_clock::now() - start >= budget) break;
+
+        if (!m_rejected.empty()) {
+            completion = std::move(m_rejected.front());
+            m_rejected.pop_front();
+        } else if (!m_completions.Pop(completion)) {
+            break;
+        }
+        m_pending--;
+        Deliver(completion);
+        completion = Completion();
+    }
+}
+
+void HttpClient::Deliver(Completion& completion) {
+    Receiver& receiver = completion.receiver;
+    if (!receiver.callback) return;
+    if (receiver.hasOwner && receiver.owner.expired()) return;
+    receiver.callback(completion.response);
+}
+
+void HttpClient::WorkerLoop() {
+    CURLM* multi = static_cast<CURLM*>(m_multi);
+    std::vector<std::unique_ptr<Transfer>> idle;
+    std::deque<Completion> backlog;     // Finished while the completion queue was full
+    std::deque<QueuedRequest> incoming;
+    std::vector<Transfer*> active;      // Owned while attached to the multi handle
+    std::vector<HttpRequestId> cancellations;
+
+    // Detaches a transfer from curl and keeps its handle for reuse
+    auto retire = [&](size_t index) -> std::unique_ptr<Transfer> {
+        std::unique_ptr<Transfer> transfer(active[index]);
+        active[index] = active.back();
+        active.pop_back();
+        curl_multi_remove_handle(multi, transfer->easy);
+        curl_slist_free_all(transfer->headers);
+        transfer->headers = nullptr;
+        return transfer;
+    };
+
+    while (m_running) {
+        {
+            std::lock_guard<std::mutex> lock(m_requestMutex);
+            incoming.swap(m_requests);
+            cancellations.swap(m_cancellations);
+        }
+
+        for (QueuedRequest& queued : incoming) {
+            std::unique_ptr<Transfer> transfer;
+            if (!idle.empty()) {
+                transfer = std::move(idle.back());
+                idle.pop_back();
+                curl_easy_reset(transfer->easy);
+            } else {
+                transfer.reset(new Transfer());
+                transfer->easy = curl_easy_init();
+            }
+
+            if (!transfer->easy) {
+                Completion completion;
+                completion.receiver = std::move(queued.receiver);
+                SetError(completion.response, "Failed to create HTTP handle");
+                backlog.push_back(std::move(completion));
+                continue;
+            }
+
+            transfer->id = queued.id;
+            transfer->request = std::move(queued.request);
+            transfer->receiver = std::move(queued.receiver);
+            transfer->response.clear();
+
+            const HttpRequest& request = transfer->request;
+            CURL* easy = transfer->easy;
+            curl_easy_setopt(easy, CURLOPT_URL, request.url.c_str());
+            curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, static_cast<long>(request.timeoutMs));
+            curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+            curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+            // Any encoding curl can decode; the server compresses large responses
+            curl_easy_setopt(easy, CURLOPT_ACCEPT_ENCODING, "");
+            if (request.method == "POST") {
+                curl_easy_setopt(easy, CURLOPT_POST, 1L);
+                curl_easy_setopt(easy, CURLOPT_POSTFIELDS, request.body.data());
+                curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE, static_cast<long>(request.body.size()));
+            } else if (request.method != "GET") {
+                curl_easy_setopt(easy, CURLOPT_CUSTOMREQUEST, request.method.c_str());
+                if (!request.body.empty()) {
+                    curl_easy_setopt(easy, CURLOPT_POSTFIELDS, request.body.data());
+                    curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE, static_cast<long>(request.body.size()));
+                }
+            }
+
+            for (const std::string& header : request.headers) {
+                transfer->headers = curl_slist_append(transfer->headers, header.c_str());
+            }
+            curl_easy_setopt(easy, CURLOPT_HTTPHEADER, transfer->headers);
+            curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, AppendBody);
+            curl_easy_setopt(easy, CURLOPT_WRITEDATA, &transfer->response);
+            curl_easy_setopt(easy, CURLOPT_PRIVATE, transfer.get());
+
+            curl_multi_add_handle(multi, easy);
+            active.push_back(transfer.release());
+        }
+        incoming.clear();
+
+        for (HttpRequestId id : cancellations) {
+            for (size_t i = 0; i < active.size(); ++i) {
+                if (active[i]->id != id) continue;
+                std::unique_ptr<Transfer> transfer = retire(i);
+                Completion completion;
+                completion.receiver = std::move(transfer->receiver);
+                SetError(completion.response, "Cancelled");
+                backlog.push_back(std::move(completion));
+                idle.push_back(std::move(transfer));
+                break;
+            }
+        }
+        cancellations.clear();
+
+        int running = 0;
+        curl_multi_perform(multi, &running);
+
+        int remaining = 0;
+        while (CURLMsg* message = curl_multi_info_read(multi, &remaining)) {
+            if (message->msg != CURLMSG_DONE) continue;
+
+            Transfer* raw = nullptr;
+            curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &raw);
+            CURLcode result = message->data.result;
+            size_t index = 0;
+            while (active[index] != raw) ++index;
+            std::unique_ptr<Transfer> transfer = retire(index);
+
+            Completion completion;
+            completion.receiver = std::move(transfer->receiver);
+            if (result == CURLE_OK) {
+                long httpCode = 0;
+                curl_easy_getinfo(transfer->easy, CURLINFO_RESPONSE_CODE, &httpCode);
+                completion.response.statusCode = static_cast<int>(httpCode);
+                completion.response.success = httpCode >= 200 && httpCode < 300;
+                completion.response.data.swap(transfer->response);
+                char* contentType = nullptr;
+                curl_easy_getinfo(transfer->easy, CURLINFO_CONTENT_TYPE, &contentType);
+                if (contentType) {
+                    completion.response.contentType = contentType;
+                }
+                if (!completion.response.success) {
+                    completion.response.error = "HTTP " + std::to_string(httpCode);
+                }
+            } else {
+                SetError(completion.response, curl_easy_strerror(result));
+            }
+            backlog.push_back(std::move(completion));
+            idle.push_back(std::move(transfer));
+        }
+
+        while (!backlog.empty() && m_completions.Push(std::move(backlog.front()))) {
+            backlog.pop_front();
+        }
+
+        curl_multi_poll(multi, nullptr, 0, backlog.empty() ? kIdleWaitMs : kBackedUpWaitMs, nullptr);
+    }
+
+    // Abort whatever is still in flight
+    for (Transfer* transfer : active) {
+        curl_multi_remove_handle(multi, transfer->easy);
+        curl_slist_free_all(transfer->headers);
+        curl_easy_cleanup(transfer->easy);
+        delete transfer;
+    }
+    for (std::unique_ptr<Transfer>& transfer : idle) {
+        curl_easy_cleanup(transfer->easy);
+    }
+}
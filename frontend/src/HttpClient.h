@@ -0,0 +1,104 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include "NetworkManager.h"
+#include "SpscQueue.h"
+
+struct HttpRequest {
+    std::string method = "GET";
+    std::string url;                    // Absolute
+    std::string body;
+    std::vector<std::string> headers;   // "Name: value"
+    int timeoutMs = 30000;
+};
+
+// Asynchronous HTTP on one persistent worker thread.
+//
+// The worker drives every transfer through a single curl multi handle, so
+// connections stay alive between requests and many requests run at once
+// without a thread each. Send() hands a request to the worker through a
+// bounded queue; finished responses come back through a lock-free queue
+// and their callbacks run on whichever thread calls Dispatch(), which is
+// the main thread.
+//
+// Callbacks usually capture the object that sent the request. Passing an
+// owner token ties the callback to that object's lifetime: once the last
+// shared_ptr to the token is gone, the response is discarded instead.
+class HttpClient {
+public:
+    static constexpr size_t kMaxQueuedRequests = 256;
+    static constexpr size_t kCompletionCapacity = 256;
+
+    HttpClient();
+    ~HttpClient();
+
+    bool Initialize();
+    void Shutdown();
+
+    // The callback runs exactly once from a later Dispatch(), with an error
+    // response if the request couldn't be queued (Send returns 0 then),
+    // unless the owner has expired by that time
+    HttpRequestId Send(HttpRequest request, HttpCallback callback, std::weak_ptr<void> owner);
+    HttpRequestId Send(HttpRequest request, HttpCallback callback);
+
+    // Aborts a request that hasn't finished; its callback gets a
+    // "Cancelled" error. A request already on the wire may still have
+    // reached the server.
+    void Cancel(HttpRequestId id);
+
+    // Runs the callbacks of finished requests until budgetSeconds have
+    // passed; the rest wait for the next call. At least one runs per call
+    // so a slow callback can't stall delivery.
+    void Dispatch(double budgetSeconds);
+
+    // Requests sent whose callback hasn't run yet
+    int GetPendingCount() const { return m_pending; }
+
+private:
+    // Where a response goes once it is done
+    struct Receiver {
+        HttpCallback callback;
+        std::weak_ptr<void> owner;
+        bool hasOwner = false;
+    };
+
+    struct Completion {
+        Receiver receiver;
+        HttpResponse response;
+    };
+
+    struct QueuedRequest {
+        HttpRequestId id;
+        HttpRequest request;
+        Receiver receiver;
+    };
+
+    struct Transfer;
+
+    void* m_multi;                      // CURLM*, opaque to keep curl out of this header
+    std::thread m_worker;
+    std::atomic<bool> m_running;
+
+    // Main thread -> worker
+    std::mutex m_requestMutex;
+    std::deque<QueuedRequest> m_requests;
+    std::vector<HttpRequestId> m_cancellations;     // Already handed to curl
+
+    // Worker -> main thread
+    SpscQueue<Completion, kCompletionCapacity> m_completions;
+
+    // Main thread only
+    std::deque<Completion> m_rejected;  // Never reached the worker
+    int m_pending;
+    HttpRequestId m_nextId;
+
+    HttpRequestId Enqueue(HttpRequest request, Receiver receiver);
+    void WorkerLoop();
+    void Deliver(Completion& completion);
+};
@@ -0,0 +1,202 @@
+#include "JobSystem.h"
+#include <iostream>
+#include <chrono>
+
+namespace {
+// Queue owned by the current thread (0 = main thread)
+thread_local int t_queueIndex = 0;
+
+// Rounds of stealing attempts before an idle worker goes to sleep
+constexpr int kIdleSpins = 64;
+}
+
+bool JobSystem::JobQueue::Push(const Job& job) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_count == kCapacity) return false;
+    m_jobs[(m_head + m_count) % kCapacity] = job;
+    m_count++;
+    return true;
+}
+
+bool JobSystem::JobQueue::Pop(Job& job) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_count == 0) return false;
+    m_count--;
+    job = m_jobs[(m_head + m_count) % kCapacity];
+    return true;
+}
+
+bool JobSystem::JobQueue::Steal(Job& job) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_count == 0) return false;
+    job = m_jobs[m_head];
+    m_head = (m_head + 1) % kCapacity;
+    m_count--;
+    return true;
+}
+
+JobSystem::~JobSystem() {
+    Shutdown();
+}
+
+bool JobSystem::Initialize(int workerThreads) {
+    if (workerThreads < 0) workerThreads = 0;
+
+    m_running = true;
+    m_queueCount = workerThreads + 1;
+    m_queues.reset(new JobQueue[m_queueCount]);
+    t_queueIndex = 0;
+
+    try {
+        for (int i = 0; i < workerThreads; ++i) {
+            m_threads.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to start job worker: " << e.what() << std::endl;
+        Shutdown();
+        return false;
+    }
+
+    std::cout << "Job system started with " << workerThreads << " worker threads" << std::endl;
+    return true;
+}
+
+void JobSystem::Shutdown() {
+    if (!m_running) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_running = false;
+    }
+    m_wake.notify_all();
+
+    for (std::thread& thread : m_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    m_threads.clear();
+    m_queues.reset();
+    m_queueCount = 0;
+}
+
+void JobSystem::Submit(JobFunction function, void* data, size_t begin, size_t end, JobCounter* counter) {
+    Job job = { function, data, begin, end, counter, AllocationCounter::GetCurrentScope() };
+    if (counter) {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (m_threads.empty() || !m_queues[GetCurrentQueue()].Push(job)) {
+        // No workers, or our deque is full: run it here
+        Execute(job);
+        return;
+    }
+
+    m_queuedJobs.fetch_add(1, std::memory_order_release);
+    m_wake.notify_one();
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+    int index = GetCurrentQueue();
+    while (counter.pending.load(std::memory_order_acquire) > 0) {
+        if (!RunOne(index)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::WorkerLoop(int index) {
+    t_queueIndex = index;
+
+    int idle = 0;
+    while (m_running) {
+        if (RunOne(index)) {
+            idle = 0;
+            continue;
+        }
+
+        if (++idle < kIdleSpins) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Nothing to steal for a while: sleep until a job is submitted. The
+        // timeout covers a notify that races with going to sleep.
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait_for(lock, std::chrono::milliseconds(2), [this]() {
+            return !m_running || m_queuedJobs.load(std::memory_order_acquire) > 0;
+        });
+        idle = 0;
+    }
+}
+
+bool JobSystem::RunOne(int index) {
+    Job job;
+    bool found = m_queues[index].Pop(job);
+
+    // Steal from the others, starting after ourselves so thieves spread out
+    for (int i = 1; !found && i < m_queueCount; ++i) {
+        found = m_queues[(index + i) % m_queueCount].Steal(job);
+    }
+    if (!found) return false;
+
+    m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    Execute(job);
+    return true;
+}
+
+void JobSystem::Execute(const Job& job) {
+    AllocationCounter::Scope* previousScope = AllocationCounter::SetCurrentScope(job.allocationScope);
+    job.function(job.data, job.begin, job.end);
+    AllocationCounter::SetCurrentScope(previousScope);
+    if (job.counter) {
+        job.counter->pending.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+int JobSystem::GetCurrentQueue() const {
+    return t_queueIndex < m_queueCount ? t_queueIndex : 0;
+}
+
+int TaskGraph::AddTask(TaskFunction function, void* data) {
+    m_nodes.emplace_back();
+    Node& node = m_nodes.back();
+    node.function = function;
+    node.data = data;
+    node.graph = this;
+    return static_cast<int>(m_nodes.size() - 1);
+}
+
+void TaskGraph::AddDependency(int before, int after) {
+    m_nodes[before].successors.push_back(after);
+    m_nodes[after].dependencyCount++;
+}
+
+void TaskGraph::Run(JobSystem& jobs) {
+    m_jobs = &jobs;
+    for (Node& node : m_nodes) {
+        node.remaining.store(node.dependencyCount, std::memory_order_relaxed);
+    }
+
+    // Successors are submitted before their predecessor's job completes, so
+    // the counter can't reach zero while work is still to come
+    for (Node& node : m_nodes) {
+        if (node.dependencyCount == 0) {
+            jobs.Submit(&TaskGraph::RunNode, &node, 0, 0, &m_counter);
+        }
+    }
+    jobs.Wait(m_counter);
+}
+
+void TaskGraph::RunNode(void* data, size_t /*begin*/, size_t /*end*/) {
+    Node* node = static_cast<Node*>(data);
+    node->function(node->data);
+
+    TaskGraph* graph = node->graph;
+    for (int successor : node->successors) {
+        Node& next = graph->m_nodes[successor];
+        if (next.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            graph->m_jobs->Submit(&TaskGraph::RunNode, &next, 0, 0, &graph->m_counter);
+        }
+    }
+}
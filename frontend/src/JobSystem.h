@@ -0,0 +1,144 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include "AllocationCounter.h"
+
+// Work-stealing thread pool.
+//
+// Each thread (the main thread included) owns a fixed-size job deque: it
+// pushes and pops at the back, idle threads steal from the front of the
+// others. Jobs are a function pointer plus a data pointer and a range, so
+// submitting never allocates; a thread whose deque is full runs the job
+// inline instead. Waiting on a counter executes other jobs meanwhile, so
+// jobs may submit and wait on nested work.
+typedef void (*JobFunction)(void* data, size_t begin, size_t end);
+
+struct JobCounter {
+    std::atomic<int> pending{0};
+};
+
+class JobSystem {
+public:
+    JobSystem() = default;
+    ~JobSystem();
+
+    // workerThreads = 0 runs every job on the calling thread
+    bool Initialize(int workerThreads);
+    void Shutdown();
+
+    int GetWorkerCount() const { return static_cast<int>(m_threads.size()); }
+    // Threads that execute jobs (workers plus the main thread)
+    int GetThreadCount() const { return GetWorkerCount() + 1; }
+
+    void Submit(JobFunction function, void* data, size_t begin, size_t end, JobCounter* counter);
+    void Wait(JobCounter& counter);
+
+    // Runs fn(begin, end) over [0, count) in chunks of at least grainSize
+    // and returns when every chunk is done
+    template <typename Fn>
+    void ParallelFor(size_t count, size_t grainSize, const Fn& fn);
+
+private:
+    struct Job {
+        JobFunction function;
+        void* data;
+        size_t begin;
+        size_t end;
+        JobCounter* counter;
+        AllocationCounter::Scope* allocationScope;  // The submitter's
+    };
+
+    // Fixed-capacity ring; the lock is only contended when a thief steals
+    class JobQueue {
+    public:
+        static constexpr size_t kCapacity = 1024;
+
+        bool Push(const Job& job);
+        bool Pop(Job& job);     // Owner, newest first
+        bool Steal(Job& job);   // Thieves, oldest first
+
+    private:
+        std::mutex m_mutex;
+        Job m_jobs[kCapacity];
+        size_t m_head = 0;      // Oldest job
+        size_t m_count = 0;
+    };
+
+    std::vector<std::thread> m_threads;
+    std::unique_ptr<JobQueue[]> m_queues;   // Index 0 belongs to the main thread
+    int m_queueCount = 0;
+
+    std::atomic<bool> m_running{false};
+    std::atomic<int> m_queuedJobs{0};
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+
+    void WorkerLoop(int index);
+    bool RunOne(int index);
+    static void Execute(const Job& job);
+    int GetCurrentQueue() const;
+};
+
+template <typename Fn>
+void JobSystem::ParallelFor(size_t count, size_t grainSize, const Fn& fn) {
+    if (count == 0) return;
+
+    // Enough chunks to keep every thread busy and balance uneven ranges
+    size_t chunks = static_cast<size_t>(GetThreadCount()) * 4;
+    size_t chunkSize = (count + chunks - 1) / chunks;
+    if (chunkSize < grainSize) chunkSize = grainSize;
+
+    if (m_threads.empty() || chunkSize >= count) {
+        fn(static_cast<size_t>(0), count);
+        return;
+    }
+
+    JobFunction trampoline = [](void* data, size_t begin, size_t end) {
+        (*static_cast<const Fn*>(data))(begin, end);
+    };
+
+    JobCounter counter;
+    for (size_t begin = 0; begin < count; begin += chunkSize) {
+        size_t end = begin + chunkSize < count ? begin + chunkSize : count;
+        Submit(trampoline, const_cast<Fn*>(&fn), begin, end, &counter);
+    }
+    Wait(counter);
+}
+
+// Dependency graph of tasks, built once and run many times. Run() starts
+// every task without unmet dependencies and submits each successor as soon
+// as its last dependency finishes; it returns when all tasks are done.
+class TaskGraph {
+public:
+    typedef void (*TaskFunction)(void* data);
+
+    int AddTask(TaskFunction function, void* data);
+    // 'after' starts only once 'before' has finished
+    void AddDependency(int before, int after);
+
+    void Run(JobSystem& jobs);
+    bool Empty() const { return m_nodes.empty(); }
+
+private:
+    struct Node {
+        TaskFunction function;
+        void* data;
+        std::vector<int> successors;
+        int dependencyCount = 0;
+        std::atomic<int> remaining{0};
+        TaskGraph* graph = nullptr;
+    };
+
+    std::deque<Node> m_nodes;
+    JobSystem* m_jobs = nullptr;
+    JobCounter m_counter;
+
+    static void RunNode(void* data, size_t begin, size_t end);
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cmath>
+
+// Small 2D vector type and helpers for per-entity math.
+// Anything that only compares distances should use the squared forms and
+// never call sqrt.
+struct Vec2 {
+    float x = 0.0f;
+    float y = 0.0f;
+
+    Vec2() = default;
+    Vec2(float x_, float y_) : x(x_), y(y_) {}
+
+    Vec2 operator+(const Vec2& o) const { return Vec2(x + o.x, y + o.y); }
+    Vec2 operator-(const Vec2& o) const { return Vec2(x - o.x, y - o.y); }
+    Vec2 operator*(float s) const { return Vec2(x * s, y * s); }
+    Vec2& operator+=(const Vec2& o) { x += o.x; y += o.y; return *this; }
+    Vec2& operator-=(const Vec2& o) { x -= o.x; y -= o.y; return *this; }
+    Vec2& operator*=(float s) { x *= s; y *= s; return *this; }
+
+    float Dot(const Vec2& o) const { return x * o.x + y * o.y; }
+    float LengthSquared() const { return x * x + y * y; }
+};
+
+namespace Math2D {
+
+// Squared lengths below this count as zero (avoids huge reciprocals)
+constexpr float kMinLengthSquared = 1e-12f;
+
+// 1 / sqrt(v), or 0 where v is (nearly) zero
+inline float InverseSqrt(float v) {
+    return v > kMinLengthSquared ? 1.0f / std::sqrt(v) : 0.0f;
+}
+
+inline float DistanceSquared(const Vec2& a, const Vec2& b) {
+    return (a - b).LengthSquared();
+}
+
+// Strict overlap test, same result as comparing the sqrt distance to r1 + r2
+inline bool CirclesOverlap(const Vec2& a, float radiusA, const Vec2& b, float radiusB) {
+    float reach = radiusA + radiusB;
+    return DistanceSquared(a, b) < reach * reach;
+}
+
+} // namespace Math2D
@@ -0,0 +1,198 @@
+#include "MovementKernels.h"
+#include "Math2D.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define MOVEMENT_KERNELS_X86 1
+#endif
+
+namespace {
+using Math2D::kMinLengthSquared;
+
+typedef void (*SteeringKernel)(const SteeringBatch& batch, size_t begin);
+
+// Also handles the tail the vector kernels leave over
+void IntegrateScalar(const SteeringBatch& b, size_t begin) {
+    for (size_t i = begin; i < b.count; ++i) {
+        float x = b.position[i * 2];
+        float y = b.position[i * 2 + 1];
+        float dx = b.targetX - x;
+        float dy = b.targetY - y;
+        float lengthSq = dx * dx + dy * dy;
+        float inverse = Math2D::InverseSqrt(lengthSq);
+        float scale = inverse * b.acceleration[i] * b.deltaTime;
+
+        float vx = b.velocity[i * 2] + dx * scale;
+        float vy = b.velocity[i * 2 + 1] + dy * scale;
+        b.velocity[i * 2] = vx;
+        b.velocity[i * 2 + 1] = vy;
+
+        b.previousPosition[i * 2] = x;
+        b.previousPosition[i * 2 + 1] = y;
+        x += vx * b.deltaTime;
+        y += vy * b.deltaTime;
+        b.position[i * 2] = x;
+        b.position[i * 2 + 1] = y;
+
+        b.culled[i] = (x < b.minX) | (x > b.maxX) | (y < b.minY) | (y > b.maxY);
+    }
+}
+
+#if defined(MOVEMENT_KERNELS_X86)
+__attribute__((target("sse2")))
+void IntegrateSse2(const SteeringBatch& b, size_t begin) {
+    const __m128 targetX = _mm_set1_ps(b.targetX);
+    const __m128 targetY = _mm_set1_ps(b.targetY);
+    const __m128 deltaTime = _mm_set1_ps(b.deltaTime);
+    const __m128 minX = _mm_set1_ps(b.minX);
+    const __m128 maxX = _mm_set1_ps(b.maxX);
+    const __m128 minY = _mm_set1_ps(b.minY);
+    const __m128 maxY = _mm_set1_ps(b.maxY);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 threeHalves = _mm_set1_ps(1.5f);
+    const __m128 minLengthSq = _mm_set1_ps(kMinLengthSquared);
+
+    size_t i = begin;
+    for (; i + 4 <= b.count; i += 4) {
+        // De-interleave four x, y pairs into x and y lanes
+        __m128 p0 = _mm_loadu_ps(b.position + i * 2);
+        __m128 p1 = _mm_loadu_ps(b.position + i * 2 + 4);
+        __m128 x = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 y = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1));
+        __m128 v0 = _mm_loadu_ps(b.velocity + i * 2);
+        __m128 v1 = _mm_loadu_ps(b.velocity + i * 2 + 4);
+        __m128 vx = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 vy = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1));
+
+        __m128 dx = _mm_sub_ps(targetX, x);
+        __m128 dy = _mm_sub_ps(targetY, y);
+
+        // Reciprocal length: estimate plus one Newton-Raphson step
+        __m128 lengthSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 inverse = _mm_rsqrt_ps(lengthSq);
+        inverse = _mm_mul_ps(inverse, _mm_sub_ps(threeHalves,
+                  _mm_mul_ps(_mm_mul_ps(half, lengthSq), _mm_mul_ps(inverse, inverse))));
+        inverse = _mm_and_ps(inverse, _mm_cmpgt_ps(lengthSq, minLengthSq));
+
+        __m128 acceleration = _mm_mul_ps(_mm_loadu_ps(b.acceleration + i), deltaTime);
+        __m128 scale = _mm_mul_ps(inverse, acceleration);
+        vx = _mm_add_ps(vx, _mm_mul_ps(dx, scale));
+        vy = _mm_add_ps(vy, _mm_mul_ps(dy, scale));
+        _mm_storeu_ps(b.velocity + i * 2, _mm_unpacklo_ps(vx, vy));
+        _mm_storeu_ps(b.velocity + i * 2 + 4, _mm_unpackhi_ps(vx, vy));
+
+        _mm_storeu_ps(b.previousPosition + i * 2, p0);
+        _mm_storeu_ps(b.previousPosition + i * 2 + 4, p1);
+        x = _mm_add_ps(x, _mm_mul_ps(vx, deltaTime));
+        y = _mm_add_ps(y, _mm_mul_ps(vy, deltaTime));
+        _mm_storeu_ps(b.position + i * 2, _mm_unpacklo_ps(x, y));
+        _mm_storeu_ps(b.position + i * 2 + 4, _mm_unpackhi_ps(x, y));
+
+        __m128 outside = _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(x, minX), _mm_cmpgt_ps(x, maxX)),
+                                   _mm_or_ps(_mm_cmplt_ps(y, minY), _mm_cmpgt_ps(y, maxY)));
+        int mask = _mm_movemask_ps(outside);
+        for (int lane = 0; lane < 4; ++lane) {
+            b.culled[i + lane] = (mask >> lane) & 1;
+        }
+    }
+    IntegrateScalar(b, i);
+}
+
+__attribute__((target("avx2,fma")))
+void IntegrateAvx2(const SteeringBatch& b, size_t begin) {
+    const __m256 targetX = _mm256_set1_ps(b.targetX);
+    const __m256 targetY = _mm256_set1_ps(b.targetY);
+    const __m256 deltaTime = _mm256_set1_ps(b.deltaTime);
+    const __m256 minX = _mm256_set1_ps(b.minX);
+    const __m256 maxX = _mm256_set1_ps(b.maxX);
+    const __m256 minY = _mm256_set1_ps(b.minY);
+    const __m256 maxY = _mm256_set1_ps(b.maxY);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 threeHalves = _mm256_set1_ps(1.5f);
+    const __m256 minLengthSq = _mm256_set1_ps(kMinLengthSquared);
+
+    // The in-lane shuffle below leaves elements in this order; per-element
+    // streams are permuted to match and the unpack on store undoes it
+    const __m256i laneOrder = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+    static const int kLaneElement[8] = { 0, 1, 4, 5, 2, 3, 6, 7 };
+
+    size_t i = begin;
+    for (; i + 8 <= b.count; i += 8) {
+        __m256 p0 = _mm256_loadu_ps(b.position + i * 2);
+        __m256 p1 = _mm256_loadu_ps(b.position + i * 2 + 8);
+        __m256 x = _mm256_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 y = _mm256_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1));
+        __m256 v0 = _mm256_loadu_ps(b.velocity + i * 2);
+        __m256 v1 = _mm256_loadu_ps(b.velocity + i * 2 + 8);
+        __m256 vx = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 vy = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1));
+
+        __m256 dx = _mm256_sub_ps(targetX, x);
+        __m256 dy = _mm256_sub_ps(targetY, y);
+
+        __m256 lengthSq = _mm256_fmadd_ps(dx, dx, _mm256_mul_ps(dy, dy));
+        __m256 inverse = _mm256_rsqrt_ps(lengthSq);
+        inverse = _mm256_mul_ps(inverse, _mm256_fnmadd_ps(_mm256_mul_ps(half, lengthSq),
+                                                          _mm256_mul_ps(inverse, inverse), threeHalves));
+        inverse = _mm256_and_ps(inverse, _mm256_cmp_ps(lengthSq, minLengthSq, _CMP_GT_OQ));
+
+        __m256 acceleration = _mm256_permutevar8x32_ps(_mm256_loadu_ps(b.acceleration + i), laneOrder);
+        __m256 scale = _mm256_mul_ps(inverse, _mm256_mul_ps(acceleration, deltaTime));
+        vx = _mm256_fmadd_ps(dx, scale, vx);
+        vy = _mm256_fmadd_ps(dy, scale, vy);
+        _mm256_storeu_ps(b.velocity + i * 2, _mm256_unpacklo_ps(vx, vy));
+        _mm256_storeu_ps(b.velocity + i * 2 + 8, _mm256_unpackhi_ps(vx, vy));
+
+        _mm256_storeu_ps(b.previousPosition + i * 2, p0);
+        _mm256_storeu_ps(b.previousPosition + i * 2 + 8, p1);
+        x = _mm256_fmadd_ps(vx, deltaTime, x);
+        y = _mm256_fmadd_ps(vy, deltaTime, y);
+        _mm256_storeu_ps(b.position + i * 2, _mm256_unpacklo_ps(x, y));
+        _mm256_storeu_ps(b.position + i * 2 + 8, _mm256_unpackhi_ps(x, y));
+
+        __m256 outside = _mm256_or_ps(
+            _mm256_or_ps(_mm256_cmp_ps(x, minX, _CMP_LT_OQ), _mm256_cmp_ps(x, maxX, _CMP_GT_OQ)),
+            _mm256_or_ps(_mm256_cmp_ps(y, minY, _CMP_LT_OQ), _mm256_cmp_ps(y, maxY, _CMP_GT_OQ)));
+        int mask = _mm256_movemask_ps(outside);
+        for (int lane = 0; lane < 8; ++lane) {
+            b.culled[i + kLaneElement[lane]] = (mask >> lane) & 1;
+        }
+    }
+    IntegrateSse2(b, i);
+}
+#endif
+
+template <SteeringKernel Kernel>
+void IntegrateFromStart(const SteeringBatch& batch) {
+    if (batch.count == 0) return;
+    Kernel(batch, 0);
+}
+
+const SteeringKernelInfo& GetKernel() {
+    static const SteeringKernelInfo choice = GetSteeringKernels().front();
+    return choice;
+}
+}
+
+void IntegrateSteering(const SteeringBatch& batch) {
+    GetKernel().integrate(batch);
+}
+
+const char* GetSteeringKernelName() {
+    return GetKernel().name;
+}
+
+std::vector<SteeringKernelInfo> GetSteeringKernels() {
+    std::vector<SteeringKernelInfo> kernels;
+#if defined(MOVEMENT_KERNELS_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        kernels.push_back({ "AVX2", IntegrateFromStart<IntegrateAvx2> });
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        kernels.push_back({ "SSE2", IntegrateFromStart<IntegrateSse2> });
+    }
+#endif
+    kernels.push_back({ "scalar", IntegrateFromStart<IntegrateScalar> });
+    return kernels;
+}
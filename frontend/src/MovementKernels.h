@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Batched steering + integration over ECS columns.
+//
+// Positions, previous positions and velocities are interleaved x, y float
+// streams (Position/PreviousPosition/Velocity columns). For every element
+// the kernel accelerates the velocity towards the target, stores the old
+// position, integrates, and flags elements that left the bounds. The
+// implementation is picked once at startup: AVX2+FMA or SSE2 on x86
+// depending on the CPU, scalar elsewhere.
+struct SteeringBatch {
+    float* position;
+    float* previousPosition;
+    float* velocity;
+    const float* acceleration;  // Per-element steering acceleration
+    uint8_t* culled;            // Out: 1 = outside the bounds
+    size_t count;
+
+    float targetX, targetY;
+    float deltaTime;
+    float minX, minY;
+    float maxX, maxY;
+};
+
+void IntegrateSteering(const SteeringBatch& batch);
+
+// Name of the kernel selected for this CPU
+const char* GetSteeringKernelName();
+
+struct SteeringKernelInfo {
+    const char* name;
+    void (*integrate)(const SteeringBatch& batch);
+};
+
+// Every kernel this CPU can run, fastest first; IntegrateSteering uses the
+// first. The others are there for benchmarks and for checking the vector
+// paths against the scalar one.
+std::vector<SteeringKernelInfo> GetSteeringKernels();
@@ -1,15 +1,342 @@
 #include "NetworkManager.h"
 #include "HomeState.h"
+#include "HttpClient.h"
+#include <nlohmann/json.hpp>
 #include <iostream>
+#include <cstring>
+
+using json = nlohmann::json;
+
+namespace {
+// Base for the streaming response readers. Tracks nesting depth and maps
+// each object key to its index in the reader's key table, so a reader
+// only sees (depth, field, value) events and never builds a document.
+class SaxReader : public nlohmann::json_sax<json> {
+public:
+    bool null() override { return true; }
+    bool boolean(bool value) override { OnBool(value); return true; }
+    bool number_integer(number_integer_t value) override { OnNumber(static_cast<double>(value)); return true; }
+    bool number_unsigned(number_unsigned_t value) override { OnNumber(static_cast<double>(value)); return true; }
+    bool number_float(number_float_t value, const string_t&) override { OnNumber(value); return true; }
+    bool string(string_t& value) override { OnString(value); return true; }
+    bool binary(binary_t&) override { return true; }
+
+    bool start_object(std::size_t) override { return Start(false); }
+    bool start_array(std::size_t) override { return Start(true); }
+    bool end_object() override { return End(); }
+    bool end_array() override { return End(); }
+
+    bool key(string_t& name) override {
+        m_field = -1;
+        for (int i = 0; i < m_keyCount; ++i) {
+            if (name.size() == std::strlen(m_keys[i]) && name == m_keys[i]) {
+                m_field = i;
+                break;
+            }
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override {
+        return false;
+    }
+
+protected:
+    SaxReader(const char* const* keys, int keyCount) : m_keys(keys), m_keyCount(keyCount) {}
+
+    int m_depth = 0;
+    int m_field = -1;       // Key of the current value; -1 if unknown or in an array
+
+    // m_field is the container's key and m_depth its depth in both
+    virtual void OnStart(bool isArray) = 0;
+    virtual void OnEnd() = 0;
+    virtual void OnNumber(double) {}
+    virtual void OnString(string_t&) {}
+    virtual void OnBool(bool) {}
+
+private:
+    const char* const* m_keys;
+    int m_keyCount;
+
+    bool Start(bool isArray) {
+        m_depth++;
+        OnStart(isArray);
+        m_field = -1;
+        return true;
+    }
+
+    bool End() {
+        OnEnd();
+        m_depth--;
+        m_field = -1;
+        return true;
+    }
+};
+
+// Rows are the objects of the first "leaderboard" array, wherever it is
+// ({ data: { leaderboard } } or { leaderboard }). Player fields may sit in
+// a nested "profiles" object, as in score-table rows.
+class LeaderboardReader : public SaxReader {
+public:
+    explicit LeaderboardReader(std::vector<LeaderboardEntry>& entries)
+        : SaxReader(kKeys, kKeyCount), m_entries(entries) {}
+
+    bool Found() const { return m_found; }
+    // Drops rows left over from the vector's previous contents
+    void Finish() { m_entries.erase(m_entries.begin() + m_count, m_entries.end()); }
+
+private:
+    enum Field { Leaderboard, Profiles, Rank, Username, Level, Avatar, Score, SurvivalTime, Kills, AchievedAt };
+    static constexpr const char* kKeys[] = {
+        "leaderboard", "profiles", "rank", "username", "level", "avatar", "score", "survivalTime", "kills", "achievedAt"
+    };
+    static constexpr int kKeyCount = sizeof(kKeys) / sizeof(kKeys[0]);
+
+    std::vector<LeaderboardEntry>& m_entries;
+    size_t m_count = 0;
+    int m_listDepth = 0;        // Depth of the row array while inside it
+    int m_profileDepth = 0;
+    bool m_found = false;
+
+    bool InRow() const {
+        return (m_listDepth && m_depth == m_listDepth + 1) || (m_profileDepth && m_depth == m_profileDepth);
+    }
+
+    void OnStart(bool isArray) override {
+        if (isArray && m_field == Leaderboard && !m_listDepth && !m_found) {
+            m_listDepth = m_depth;
+            m_found = true;
+        } else if (!isArray && m_listDepth && m_depth == m_listDepth + 1) {
+            if (m_count == m_entries.size()) {
+                m_entries.emplace_back();
+            }
+            LeaderboardEntry& entry = m_entries[m_count++];
+            entry.rank = static_cast<int>(m_count);
+            entry.username.clear();
+            entry.level = 0;
+            entry.avatar.clear();
+            entry.score = 0;
+            entry.survivalTime = 0;
+            entry.kills = 0;
+            entry.achievedAt.clear();
+        } else if (!isArray && m_listDepth && m_depth == m_listDepth + 2 && m_field == Profiles) {
+            m_profileDepth = m_depth;
+        }
+    }
+
+    void OnEnd() override {
+        if (m_depth == m_profileDepth) {
+            m_profileDepth = 0;
+        } else if (m_depth == m_listDepth) {
+            m_listDepth = 0;
+        }
+    }
+
+    void OnNumber(double value) override {
+        if (!InRow()) return;
+        LeaderboardEntry& entry = m_entries[m_count - 1];
+        switch (m_field) {
+            case Rank: entry.rank = static_cast<int>(value); break;
+            case Level: entry.level = static_cast<int>(value); break;
+            case Score: entry.score = static_cast<int>(value); break;
+            case SurvivalTime: entry.survivalTime = static_cast<int>(value); break;
+            case Kills: entry.kills = static_cast<int>(value); break;
+            default: break;
+        }
+    }
+
+    void OnString(string_t& value) override {
+        if (!InRow()) return;
+        LeaderboardEntry& entry = m_entries[m_count - 1];
+        // assign() keeps the capacity of a reused row's strings
+        switch (m_field) {
+            case Username: entry.username.assign(value); break;
+            case Avatar: entry.avatar.assign(value); break;
+            case AchievedAt: entry.achievedAt.assign(value); break;
+            default: break;
+        }
+    }
+};
+
+// Skills are the objects of the first "skills" array; "currency" and
+// "userLevel" are read from outside it
+class SkillsReader : public SaxReader {
+public:
+    SkillsReader(std::vector<Skill>& skills, UserCurrency& currency, int& userLevel)
+        : SaxReader(kKeys, kKeyCount), m_skills(skills), m_currency(currency), m_userLevel(userLevel) {}
+
+    bool Found() const { return m_found; }
+    void Finish() { m_skills.erase(m_skills.begin() + m_count, m_skills.end()); }
+
+private:
+    enum Field {
+        Skills, Effects, Currency, UserLevel,
+        SkillId, Name, Description, Category, Icon, MaxLevel, CurrentLevel, IsUnlocked,
+        PrerequisitesMet, CanUpgrade, NextLevelCost, UnlockLevel,
+        Type, CurrentValue, NextValue, IsPercentage,
+        SkillPoints, Coins
+    };
+    static constexpr const char* kKeys[] = {
+        "skills", "effects", "currency", "userLevel",
+        "skillId", "name", "description", "category", "icon", "maxLevel", "currentLevel", "isUnlocked",
+        "prerequisitesMet", "canUpgrade", "nextLevelCost", "unlockLevel",
+        "type", "currentValue", "nextValue", "isPercentage",
+        "skillPoints", "coins"
+    };
+    static constexpr int kKeyCount = sizeof(kKeys) / sizeof(kKeys[0]);
+
+    std::vector<Skill>& m_skills;
+    UserCurrency& m_currency;
+    int& m_userLevel;
+    size_t m_count = 0;
+    size_t m_effectCount = 0;   // In the current skill
+    int m_listDepth = 0;
+    int m_effectsDepth = 0;
+    int m_currencyDepth = 0;
+    bool m_found = false;
+
+    Skill& Current() { return m_skills[m_count - 1]; }
+
+    void OnStart(bool isArray) override {
+        if (isArray && m_field == Skills && !m_listDepth && !m_found) {
+            m_listDepth = m_depth;
+            m_found = true;
+        } else if (!isArray && m_listDepth && m_depth == m_listDepth + 1) {
+            if (m_count == m_skills.size()) {
+                m_skills.emplace_back();
+            }
+            Skill& skill = m_skills[m_count++];
+            skill.skillId.clear();
+            skill.name.clear();
+            skill.description.clear();
+            skill.category.clear();
+            skill.icon.clear();
+            skill.maxLevel = 0;
+            skill.currentLevel = 0;
+            skill.isUnlocked = false;
+            skill.prerequisitesMet = false;
+            skill.canUpgrade = false;
+            skill.nextLevelCost = 0;
+            skill.unlockLevel = 0;
+            m_effectCount = 0;
+        } else if (isArray && m_listDepth && m_depth == m_listDepth + 2 && m_field == Effects) {
+            m_effectsDepth = m_depth;
+        } else if (!isArray && m_effectsDepth && m_depth == m_effectsDepth + 1) {
+            std::vector<SkillEffect>& effects = Current().effects;
+            if (m_effectCount == effects.size()) {
+                effects.emplace_back();
+            }
+            SkillEffect& effect = effects[m_effectCount++];
+            effect.type.clear();
+            effect.currentValue = 0.0f;
+            effect.nextValue = 0.0f;
+            effect.isPercentage = false;
+        } else if (!isArray && !m_listDepth && m_field == Currency && !m_currencyDepth) {
+            m_currencyDepth = m_depth;
+        }
+    }
+
+    void OnEnd() override {
+        if (m_depth == m_effectsDepth) {
+            m_effectsDepth = 0;
+        } else if (m_listDepth && m_depth == m_listDepth + 1) {
+            std::vector<SkillEffect>& effects = Current().effects;
+            effects.erase(effects.begin() + m_effectCount, effects.end());
+        } else if (m_depth == m_listDepth) {
+            m_listDepth = 0;
+        } else if (m_depth == m_currencyDepth) {
+            m_currencyDepth = 0;
+        }
+    }
+
+    void OnNumber(double value) override {
+        if (m_effectsDepth && m_depth == m_effectsDepth + 1) {
+            SkillEffect& effect = Current().effects[m_effectCount - 1];
+            if (m_field == CurrentValue) effect.currentValue = static_cast<float>(value);
+            else if (m_field == NextValue) effect.nextValue = static_cast<float>(value);
+        } else if (m_listDepth && m_depth == m_listDepth + 1) {
+            Skill& skill = Current();
+            switch (m_field) {
+                case MaxLevel: skill.maxLevel = static_cast<int>(value); break;
+                case CurrentLevel: skill.currentLevel = static_cast<int>(value); break;
+                case NextLevelCost: skill.nextLevelCost = static_cast<int>(value); break;
+                case UnlockLevel: skill.unlockLevel = static_cast<int>(value); break;
+                default: break;
+            }
+        } else if (m_currencyDepth && m_depth == m_currencyDepth) {
+            if (m_field == SkillPoints) m_currency.skillPoints = static_cast<int>(value);
+            else if (m_field == Coins) m_currency.coins = static_cast<int>(value);
+        } else if (!m_listDepth && m_field == UserLevel) {
+            m_userLevel = static_cast<int>(value);
+        }
+    }
+
+    void OnString(string_t& value) override {
+        if (m_effectsDepth && m_depth == m_effectsDepth + 1) {
+            if (m_field == Type) Current().effects[m_effectCount - 1].type.assign(value);
+        } else if (m_listDepth && m_depth == m_listDepth + 1) {
+            Skill& skill = Current();
+            switch (m_field) {
+                case SkillId: skill.skillId.assign(value); break;
+                case Name: skill.name.assign(value); break;
+                case Description: skill.description.assign(value); break;
+                case Category: skill.category.assign(value); break;
+                case Icon: skill.icon.assign(value); break;
+                default: break;
+            }
+        }
+    }
+
+    void OnBool(bool value) override {
+        if (m_effectsDepth && m_depth == m_effectsDepth + 1) {
+            if (m_field == IsPercentage) Current().effects[m_effectCount - 1].isPercentage = value;
+        } else if (m_listDepth && m_depth == m_listDepth + 1) {
+            Skill& skill = Current();
+            switch (m_field) {
+                case IsUnlocked: skill.isUnlocked = value; break;
+                case PrerequisitesMet: skill.prerequisitesMet = value; break;
+                case CanUpgrade: skill.canUpgrade = value; break;
+                default: break;
+            }
+        }
+    }
+};
+}
 
-// Simple implementation for demo purposes
 struct NetworkManager::Impl {
     std::string baseUrl;
     std::string authToken;
-    bool loading = false;
+    int timeoutMs;
+    HttpClient* client;
+    int pendingRequests;
+    
+    // Parse targets shared by every response, so their rows and strings
+    // are reused from one refresh to the next
+    std::vector<LeaderboardEntry> leaderboard;
+    std::vector<Skill> skills;
+    
+    // Expires with this object; responses that arrive later are dropped
+    std::shared_ptr<int> alive;
+    
+    explicit Impl(HttpClient* httpClient)
+        : baseUrl("http://localhost:3000"), timeoutMs(30000), client(httpClient)
+        , pendingRequests(0), alive(std::make_shared<int>(0)) {}
 };
 
-NetworkManager::NetworkManager() : m_impl(std::make_unique<Impl>()) {}
+namespace {
+// The API's { "error": "..." } message if the body has one
+std::string ErrorMessage(const HttpResponse& response) {
+    if (response.statusCode != 0) {
+        json body = json::parse(response.data, nullptr, false);
+        if (body.is_object() && body.contains("error") && body["error"].is_string()) {
+            return body["error"].get<std::string>();
+        }
+    }
+    return response.error;
+}
+}
+
+NetworkManager::NetworkManager(HttpClient* client) : m_impl(std::make_unique<Impl>(client)) {}
 
 NetworkManager::~NetworkManager() = default;
 
@@ -17,94 +344,131 @@ void NetworkManager::SetBaseUrl(const std::string& baseUrl) {
     m_impl->baseUrl = baseUrl;
 }
 
+void NetworkManager::SetTimeout(int timeoutMs) {
+    m_impl->timeoutMs = timeoutMs;
+}
+
 void NetworkManager::SetAuthToken(const std::string& token) {
     m_impl->authToken = token;
 }
 
 void NetworkManager::GetScoreLeaderboard(const std::string& timeframe, int limit, LeaderboardCallback callback) {
-    // TODO: Implement actual HTTP client to call API
-    // For now, return empty data until real API integration is implemented
-    std::vector<LeaderboardEntry> emptyData;
-    callback(true, emptyData, "");
+    GetLeaderboard("/api/leaderboard/scores?timeframe=" + timeframe + "&limit=" + std::to_string(limit),
+                   limit, std::move(callback));
 }
 
 void NetworkManager::GetSurvivalLeaderboard(int limit, LeaderboardCallback callback) {
-    // TODO: Implement actual HTTP client to call API
-    std::vector<LeaderboardEntry> emptyData;
-    callback(true, emptyData, "");
+    GetLeaderboard("/api/leaderboard/survival?limit=" + std::to_string(limit), limit, std::move(callback));
 }
 
 void NetworkManager::GetKillsLeaderboard(int limit, LeaderboardCallback callback) {
-    // TODO: Implement actual HTTP client to call API
-    std::vector<LeaderboardEntry> emptyData;
-    callback(true, emptyData, "");
+    GetLeaderboard("/api/leaderboard/kills?limit=" + std::to_string(limit), limit, std::move(callback));
 }
 
 void NetworkManager::GetRecentLeaderboard(int limit, LeaderboardCallback callback) {
-    // TODO: Implement actual HTTP client to call API
-    std::vector<LeaderboardEntry> emptyData;
-    callback(true, emptyData, "");
+    GetLeaderboard("/api/leaderboard/recent?limit=" + std::to_string(limit), limit, std::move(callback));
+}
+
+void NetworkManager::GetLeaderboard(const std::string& endpoint, int limit, LeaderboardCallback callback) {
+    Impl* impl = m_impl.get();
+    MakeHttpRequest(endpoint, "GET", "", [impl, limit, callback](const HttpResponse& response) {
+        std::vector<LeaderboardEntry>& entries = impl->leaderboard;
+        if (limit > 0) {
+            entries.reserve(static_cast<size_t>(limit));
+        }
+        if (!response.success) {
+            entries.clear();
+            callback(false, entries, ErrorMessage(response));
+        } else if (!ParseLeaderboardResponse(response.data, entries)) {
+            entries.clear();
+            callback(false, entries, "Failed to parse leaderboard");
+        } else {
+            callback(true, entries, "");
+        }
+    });
 }
 
 void NetworkManager::GetUserSkills(SkillsCallback callback) {
-    // TODO: Implement actual HTTP client to call API
-    std::vector<Skill> emptySkills;
-    UserCurrency currency = {0, 50}; // Real user data will be fetched from API
-    callback(true, emptySkills, currency, 1, "");
+    Impl* impl = m_impl.get();
+    MakeHttpRequest("/api/skills/user", "GET", "", [impl, callback](const HttpResponse& response) {
+        std::vector<Skill>& skills = impl->skills;
+        UserCurrency currency = {0, 0};
+        int userLevel = 1;
+        if (!response.success) {
+            skills.clear();
+            callback(false, skills, currency, userLevel, ErrorMessage(response));
+        } else if (!ParseSkillsResponse(response.data, skills, currency, userLevel)) {
+            skills.clear();
+            callback(false, skills, currency, userLevel, "Failed to parse skills");
+        } else {
+            callback(true, skills, currency, userLevel, "");
+        }
+    });
 }
 
 void NetworkManager::GetUserStats(HttpCallback callback) {
-    // TODO: Implement actual HTTP client to call /api/game/current-stats
-    // For now, simulate loading user stats from persistent storage
-    HttpResponse response;
-    response.success = true;
-    response.statusCode = 200;
-    response.data = R"({
-        "success": true,
-        "data": {
-            "username": "Player",
-            "level": 1,
-            "leaderboard_points": 0,
-            "skill_points": 0,
-            "coins": 50,
-            "best_score": 0,
-            "experience": 0
-        }
-    })";
-    response.error = "";
-    
-    // Simulate async callback
-    callback(response);
+    MakeHttpRequest("/api/game/stats", "GET", "", std::move(callback));
 }
 
 void NetworkManager::UpgradeSkill(const std::string& skillId, UpgradeCallback callback) {
-    // Demo implementation
-    callback(true, skillId, 4, 100, "");
-}
-
-void NetworkManager::Update() {
-    // Process async operations
+    json requestBody;
+    requestBody["skillId"] = skillId;
+    
+    MakeHttpRequest("/api/skills/upgrade", "POST", requestBody.dump(), [skillId, callback](const HttpResponse& response) {
+        if (!response.success) {
+            callback(false, skillId, 0, 0, ErrorMessage(response));
+            return;
+        }
+        
+        json body = json::parse(response.data, nullptr, false);
+        if (!body.is_object() || !body.contains("data") || !body["data"].is_object()) {
+            callback(false, skillId, 0, 0, "Failed to parse upgrade response");
+            return;
+        }
+        const json& data = body["data"];
+        int newLevel = 0;
+        if (data.contains("skill") && data["skill"].is_object()) {
+            newLevel = data["skill"].value("newLevel", 0);
+        }
+        callback(true, skillId, newLevel, data.value("remainingSkillPoints", 0), "");
+    });
 }
 
 bool NetworkManager::IsLoading() const {
-    return m_impl->loading;
-}
-
-ApiResponse NetworkManager::MakeRequest(const std::string& endpoint, const std::string& method, const std::string& body) {
-    // Demo implementation
-    return {true, "", "{}"};
+    return m_impl->pendingRequests > 0;
 }
 
-void NetworkManager::MakeAsyncRequest(const std::string& endpoint, const std::string& method, const std::string& body, std::function<void(const ApiResponse&)> callback) {
-    // Demo implementation
+HttpRequestId NetworkManager::MakeHttpRequest(const std::string& endpoint, const std::string& method,
+                                              const std::string& body, HttpCallback callback) {
+    HttpRequest request;
+    request.method = method;
+    request.url = m_impl->baseUrl + endpoint;
+    request.body = body;
+    request.timeoutMs = m_impl->timeoutMs;
+    request.headers.push_back("Content-Type: application/json");
+    if (!m_impl->authToken.empty()) {
+        request.headers.push_back("Authorization: Bearer " + m_impl->authToken);
+    }
+    
+    Impl* impl = m_impl.get();
+    impl->pendingRequests++;
+    return impl->client->Send(std::move(request), [impl, callback](const HttpResponse& response) {
+        impl->pendingRequests--;
+        callback(response);
+    }, impl->alive);
 }
 
-std::vector<LeaderboardEntry> NetworkManager::ParseLeaderboardResponse(const std::string& jsonData) {
-    // Demo implementation
-    return {};
+bool NetworkManager::ParseLeaderboardResponse(const std::string& jsonData, std::vector<LeaderboardEntry>& entries) {
+    LeaderboardReader reader(entries);
+    bool parsed = json::sax_parse(jsonData, &reader);
+    reader.Finish();
+    return parsed && reader.Found();
 }
 
-std::vector<Skill> NetworkManager::ParseSkillsResponse(const std::string& jsonData, UserCurrency& currency, int& userLevel) {
-    // Demo implementation
-    return {};
+bool NetworkManager::ParseSkillsResponse(const std::string& jsonData, std::vector<Skill>& skills,
+                                         UserCurrency& currency, int& userLevel) {
+    SkillsReader reader(skills, currency, userLevel);
+    bool parsed = json::sax_parse(jsonData, &reader);
+    reader.Finish();
+    return parsed && reader.Found();
 } 
\ No newline at end of file
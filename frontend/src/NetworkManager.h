@@ -4,6 +4,7 @@
 #include <functional>
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 // Forward declarations
 struct LeaderboardEntry;
@@ -11,32 +12,38 @@ struct Skill;
 struct UserCurrency;
 
 // Response structures
-struct ApiResponse {
-    bool success;
-    std::string error;
-    std::string data;
-};
-
 struct HttpResponse {
     bool success;
     int statusCode;
     std::string data;
     std::string error;
+    std::string contentType;        // Empty if the server sent none
 };
 
 // Callback types
 using HttpCallback = std::function<void(const HttpResponse& response)>;
+using HttpRequestId = uint64_t;     // 0 = no request
 using LeaderboardCallback = std::function<void(bool success, const std::vector<LeaderboardEntry>& entries, const std::string& error)>;
 using SkillsCallback = std::function<void(bool success, const std::vector<Skill>& skills, const UserCurrency& currency, int userLevel, const std::string& error)>;
 using UpgradeCallback = std::function<void(bool success, const std::string& skillId, int newLevel, int remainingSkillPoints, const std::string& error)>;
 
+class HttpClient;
+
+// Leaderboard, skills and stats API calls for the home screen.
+//
+// Requests go through the shared HttpClient, so everything sent together
+// is in flight at once over pooled connections. Callbacks run on the main
+// thread when Game dispatches network completions, and never after this
+// object is destroyed. The vectors passed to callbacks are only valid
+// during the call.
 class NetworkManager {
 public:
-    NetworkManager();
+    explicit NetworkManager(HttpClient* client);
     ~NetworkManager();
 
     // Configuration
     void SetBaseUrl(const std::string& baseUrl);
+    void SetTimeout(int timeoutMs);
     void SetAuthToken(const std::string& token);
     
     // Leaderboard API calls
@@ -50,21 +57,23 @@ public:
     void GetUserStats(HttpCallback callback);
     void UpgradeSkill(const std::string& skillId, UpgradeCallback callback);
     
-    // Update method for processing async requests
-    void Update();
-    
     // Check if network operations are in progress
     bool IsLoading() const;
+    
+    // JSON parsing helpers
+    // These stream the body: rows are written straight into the vector,
+    // reusing its elements and capacity, without building a JSON document.
+    // They return false if the body is malformed or has no row array.
+    static bool ParseLeaderboardResponse(const std::string& jsonData, std::vector<LeaderboardEntry>& entries);
+    static bool ParseSkillsResponse(const std::string& jsonData, std::vector<Skill>& skills,
+                                    UserCurrency& currency, int& userLevel);
 
 private:
     struct Impl;
     std::unique_ptr<Impl> m_impl;
     
     // HTTP request helpers
-    ApiResponse MakeRequest(const std::string& endpoint, const std::string& method = "GET", const std::string& body = "");
-    void MakeAsyncRequest(const std::string& endpoint, const std::string& method, const std::string& body, std::function<void(const ApiResponse&)> callback);
-    
-    // JSON parsing helpers
-    std::vector<LeaderboardEntry> ParseLeaderboardResponse(const std::string& jsonData);
-    std::vector<Skill> ParseSkillsResponse(const std::string& jsonData, UserCurrency& currency, int& userLevel);
+    HttpRequestId MakeHttpRequest(const std::string& endpoint, const std::string& method,
+                                  const std::string& body, HttpCallback callback);
+    void GetLeaderboard(const std::string& endpoint, int limit, LeaderboardCallback callback);
 }; 
\ No newline at end of file
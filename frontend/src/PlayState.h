@@ -1,27 +1,19 @@
 #pragma once
 
 #include "GameState.h"
+#include "SpatialHash.h"
+#include "ECS.h"
+#include "Components.h"
+#include "SnapshotBuffer.h"
+#include "AllocationCounter.h"
+#include "Random.h"
+#include "WaveDirector.h"
 #include <vector>
 #include <memory>
 #include <string>
 
 // Forward declarations
-class AuthNetworkManager;
-
-struct Enemy {
-    float x, y;
-    float vx, vy;
-    int type;
-    bool active;
-    float size;
-};
-
-struct PowerUp {
-    float x, y;
-    bool active;
-    int type;
-    float pulseTime;
-};
+class ProgressSync;
 
 class PlayState : public GameState {
 public:
@@ -36,6 +28,10 @@ public:
     void Render(Renderer* renderer) override;
     void RenderUI() override;
     
+    // Pipelined mode: Render() and the HUD draw from a snapshot
+    bool UsesRenderSnapshot() const override { return true; }
+    void ProduceRenderSnapshot() override;
+    
     // Authentication
     void SetAuthToken(const std::string& token);
 
@@ -44,6 +40,10 @@ private:
     float m_playerX;
     float m_playerY;
     
+    // World bounds from the viewport (logical units, not pixels)
+    float m_worldWidth;
+    float m_worldHeight;
+    
     // Game state
     bool m_paused;
     float m_gameTime;
@@ -57,21 +57,64 @@ private:
     float m_skillPointTimer;    // Timer for skill points (2 second intervals)
     float m_saveTimer;          // Timer for saving progress (every 5 seconds)
     
-    // Session management
-    std::string m_sessionId;    // Current game session ID
-    bool m_sessionStarted;      // Whether a session is active
-    
     // Game state backup for continue feature
     float m_savedGameTime;
     int m_savedScore;
     int m_savedLeaderboardPoints;
     int m_savedSkillPoints;
-    std::vector<Enemy> m_savedEnemies;
-    std::vector<PowerUp> m_savedPowerUps;
+    World m_savedWorld;
+    Random m_savedEnemyRandom;
+    Random m_savedPowerUpRandom;
+    WaveDirector m_savedWaveDirector;
     
-    // Game entities
-    std::vector<Enemy> m_enemies;
-    std::vector<PowerUp> m_powerUps;
+    // Everything Render() and the HUD need from one frame, captured after
+    // the simulation ticks so the world can move on while it is drawn
+    struct SpriteInstance {
+        float x, y;             // Already interpolated
+        Sprite sprite;
+        float time;             // Pulse phase
+    };
+    struct RenderSnapshot {
+        std::vector<SpriteInstance> sprites;
+        float playerX = 0.0f;
+        float playerY = 0.0f;
+        int score = 0;
+        int lives = 0;
+        float gameTime = 0.0f;
+        int leaderboardPoints = 0;
+        int skillPoints = 0;
+        int wave = 0;
+    };
+    SnapshotBuffer<RenderSnapshot> m_snapshots;
+    const RenderSnapshot* m_drawnSnapshot;  // The one Render() drew this frame
+    
+    // Game entities (enemies and power-ups) and the systems that run them
+    struct SystemContext {
+        float deltaTime;
+        float interpolation;        // Snapshot only: blend between the last two ticks
+        RenderSnapshot* snapshot;   // Snapshot only
+        JobSystem* jobs;            // Simulation only
+    };
+    enum SystemPhase {
+        kSimulationPhase,
+        kSnapshotPhase
+    };
+    World m_world;
+    SystemScheduler<SystemContext> m_systems;
+    
+    // Spawn schedule; its caps also size the entity pool
+    WaveDirector m_waveDirector;
+    AllocationCounter::Scope m_simulationAllocations;   // operator new calls by the simulation systems
+    
+    // Session seed and the spawn streams derived from it
+    uint64_t m_seed;
+    Random m_enemyRandom;
+    Random m_powerUpRandom;
+    
+    // Per-tick scratch reused by the systems
+    SpatialHash m_collisionGrid;
+    std::vector<Entity> m_colliderEntities;    // Grid id -> entity
+    std::vector<uint8_t> m_culled;
     
     // UI state
     bool m_showPauseMenu;
@@ -79,21 +122,29 @@ private:
     bool m_canContinue;
     
     // Network
-    std::unique_ptr<AuthNetworkManager> m_authNetworkManager;
+    std::string m_authToken;
+    std::unique_ptr<ProgressSync> m_progressSync;   // Session events, via the journal
     
     // Game mechanics
-    void SpawnEnemies();
+    void UpdateWorldBounds();
+    void SpawnEnemies(const WaveDirector::Spawn& spawn);
     void SpawnPowerUps();
-    void UpdateEnemies(float deltaTime);
-    void UpdatePowerUps(float deltaTime);
-    void CheckCollisions();
-    bool CircleCollision(float x1, float y1, float r1, float x2, float y2, float r2);
+    
+    // Systems
+    void ReserveEntityPool();
+    void RegisterSystems();
+    void SpawnSystem(World& world, const SystemContext& context);
+    void MovementSystem(World& world, const SystemContext& context);
+    void PulseSystem(World& world, const SystemContext& context);
+    void CollisionSystem(World& world, const SystemContext& context);
+    void SnapshotSystem(World& world, const SystemContext& context);
     
     // Point system
     void UpdatePointSystem(float deltaTime);
     void SaveProgressToServer();
     
     // Session management
+    void SeedRandom(uint64_t seed);
     void StartGameSession();
     void EndGameSession();
     
@@ -101,4 +152,7 @@ private:
     void SaveGameState();
     void RestoreGameState();
     void RestartGame();
+    
+    // Back to the home screen, still signed in
+    void ReturnToHome();
 }; 
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "ProgressSync.h"
+#include "SessionJournal.h"
+#include <iostream>
+
+ProgressSync::ProgressSync(SessionJournal* journal)
+    : m_journal(journal)
+    , m_hasSaved(false)
+    , m_ended(false)
+{
+}
+
+void ProgressSync::BeginSession(uint64_t seed) {
+    m_sessionId = m_journal->BeginSession(seed);
+    m_hasSaved = false;
+    m_ended = false;
+}
+
+void ProgressSync::SaveProgress(const ProgressSnapshot& progress) {
+    if (!HasSession()) {
+        std::cout << "Cannot save progress - no active session" << std::endl;
+        return;
+    }
+    if (m_hasSaved && SameProgress(progress, m_lastSaved)) {
+        return;
+    }
+
+    m_lastSaved = progress;
+    m_hasSaved = true;
+    m_journal->RecordProgress(m_sessionId, progress);
+}
+
+void ProgressSync::EndSession(const SessionResult& result) {
+    if (!HasSession()) return;
+
+    const ProgressSnapshot& progress = result.progress;
+    std::cout << "Ending game session..." << std::endl;
+    std::cout << "  Final Score: " << progress.score << std::endl;
+    std::cout << "  Final Leaderboard Points: " << progress.leaderboardPoints << std::endl;
+    std::cout << "  Final Skill Points: " << progress.skillPoints << std::endl;
+    std::cout << "  Final Survival Time: " << progress.survivalTime << " seconds" << std::endl;
+
+    m_ended = true;
+    m_journal->RecordEnd(m_sessionId, result);
+}
+
+bool ProgressSync::SameProgress(const ProgressSnapshot& a, const ProgressSnapshot& b) {
+    // Survival time alone always changes; it isn't worth a request
+    return a.score == b.score &&
+           a.leaderboardPoints == b.leaderboardPoints &&
+           a.skillPoints == b.skillPoints &&
+           a.livesRemaining == b.livesRemaining;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+class SessionJournal;
+
+// What a progress save reports to the server
+struct ProgressSnapshot {
+    int score = 0;
+    int leaderboardPoints = 0;
+    int skillPoints = 0;
+    float survivalTime = 0.0f;
+    int livesRemaining = 0;
+};
+
+// What session/end reports; includes the final progress
+struct SessionResult {
+    ProgressSnapshot progress;
+    int kills = 0;
+    int damageDealt = 0;
+    int damageTaken = 0;
+    int waveReached = 0;
+};
+
+// One PlayState's view of its current game session.
+//
+// Everything is recorded in the session journal, which uploads it when
+// the server is reachable and sends only the newest progress. Saves that
+// change nothing but the survival time aren't recorded, and the session
+// ends only once however often EndSession is called.
+class ProgressSync {
+public:
+    explicit ProgressSync(SessionJournal* journal);
+
+    // Starts a new session, unless nobody is signed in; forgets everything
+    // about the last one
+    void BeginSession(uint64_t seed);
+    bool HasSession() const { return !m_sessionId.empty() && !m_ended; }
+
+    void SaveProgress(const ProgressSnapshot& progress);
+    void EndSession(const SessionResult& result);
+
+private:
+    SessionJournal* m_journal;
+    std::string m_sessionId;        // Local id in the journal
+
+    ProgressSnapshot m_lastSaved;
+    bool m_hasSaved;
+    bool m_ended;
+
+    static bool SameProgress(const ProgressSnapshot& a, const ProgressSnapshot& b);
+};
@@ -0,0 +1,64 @@
+#include "Random.h"
+#include <chrono>
+#include <random>
+
+void Random::Seed(uint64_t seed, uint64_t stream) {
+    // pcg32_srandom_r
+    m_state = 0;
+    m_increment = (stream << 1u) | 1u;
+    NextU32();
+    m_state += seed;
+    NextU32();
+}
+
+uint32_t Random::NextBelow(uint32_t bound) {
+    // Lemire, "Fast Random Integer Generation in an Interval" (2019). The
+    // high word of x * bound is the result; the low word tells whether x
+    // fell in the biased leftover and has to be redrawn.
+    uint64_t product = static_cast<uint64_t>(NextU32()) * bound;
+    uint32_t low = static_cast<uint32_t>(product);
+    if (low < bound) {
+        uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold) {
+            product = static_cast<uint64_t>(NextU32()) * bound;
+            low = static_cast<uint32_t>(product);
+        }
+    }
+    return static_cast<uint32_t>(product >> 32);
+}
+
+int Random::Range(int min, int max) {
+    if (max <= min) return min;
+    uint32_t span = static_cast<uint32_t>(static_cast<int64_t>(max) - min + 1);
+    if (span == 0) {
+        // Full 32-bit range
+        return static_cast<int>(NextU32());
+    }
+    return static_cast<int>(static_cast<int64_t>(min) + NextBelow(span));
+}
+
+void Random::Fill(uint32_t* out, size_t count) {
+    // Local copy keeps the state in registers across the loop
+    Random generator = *this;
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = generator.NextU32();
+    }
+    *this = generator;
+}
+
+void Random::FillFloats(float* out, size_t count, float min, float max) {
+    Random generator = *this;
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = generator.Range(min, max);
+    }
+    *this = generator;
+}
+
+uint64_t Random::GenerateSeed() {
+    std::random_device device;
+    uint64_t seed = (static_cast<uint64_t>(device()) << 32) ^ device();
+    
+    // random_device may be deterministic on some platforms; mix in the clock
+    seed ^= static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    return seed;
+}
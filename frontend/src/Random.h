@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// Seedable PCG32 generator (O'Neill's pcg32_random_r: 64-bit LCG state,
+// xorshift-rotate output).
+//
+// One game seed drives every system: each system owns its own Random
+// constructed from (seed, stream), and different streams are independent
+// sequences. Generators are plain values, so they can be copied for
+// save/restore and used from any thread as long as each stream has a
+// single owner. Bounded integers use Lemire's multiply-shift rejection, so
+// there is no modulo bias and usually no division.
+class Random {
+public:
+    Random() { Seed(0, 0); }
+    Random(uint64_t seed, uint64_t stream) { Seed(seed, stream); }
+
+    void Seed(uint64_t seed, uint64_t stream);
+
+    uint32_t NextU32() {
+        uint64_t old = m_state;
+        m_state = old * kMultiplier + m_increment;
+        uint32_t xorshifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        uint32_t rot = static_cast<uint32_t>(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+    }
+
+    // Uniform in [0, bound); bound 0 returns 0
+    uint32_t NextBelow(uint32_t bound);
+    // Uniform in [min, max], inclusive
+    int Range(int min, int max);
+
+    // Uniform in [0, 1) with 24 bits of precision
+    float NextFloat() { return static_cast<float>(NextU32() >> 8) * (1.0f / 16777216.0f); }
+    // Uniform in [min, max)
+    float Range(float min, float max) { return min + (max - min) * NextFloat(); }
+
+    // Batch fills, same sequence as calling the single-value functions
+    void Fill(uint32_t* out, size_t count);
+    void FillFloats(float* out, size_t count, float min, float max);
+
+    // Fresh 64-bit seed from the OS entropy source and the clock
+    static uint64_t GenerateSeed();
+
+private:
+    static constexpr uint64_t kMultiplier = 6364136223846793005ULL;
+
+    uint64_t m_state;
+    uint64_t m_increment;   // Always odd; selects the stream
+};
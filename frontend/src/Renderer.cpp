@@ -1,44 +1,364 @@
 #include "Renderer.h"
+#include "Viewport.h"
+#include "CircleMesh.h"
 #include <GL/glew.h>
 #include <iostream>
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+
+namespace {
+
+// Attribute slots shared by both shader variants
+const GLuint kPositionAttrib = 0;
+const GLuint kColorAttrib = 1;
+
+const char* kVertexShader330 = R"(#version 330
+in vec2 a_position;
+in vec4 a_color;
+uniform mat4 u_projection;
+out vec4 v_color;
+void main() {
+    v_color = a_color;
+    gl_Position = u_projection * vec4(a_position, 0.0, 1.0);
+}
+)";
+
+const char* kFragmentShader330 = R"(#version 330
+in vec4 v_color;
+out vec4 fragColor;
+void main() {
+    fragColor = v_color;
+}
+)";
+
+// GLSL 1.20 fallback for the OpenGL 2.1 context created by Game::InitializeSDL
+const char* kVertexShader120 = R"(#version 120
+attribute vec2 a_position;
+attribute vec4 a_color;
+uniform mat4 u_projection;
+varying vec4 v_color;
+void main() {
+    v_color = a_color;
+    gl_Position = u_projection * vec4(a_position, 0.0, 1.0);
+}
+)";
+
+const char* kFragmentShader120 = R"(#version 120
+varying vec4 v_color;
+void main() {
+    gl_FragColor = v_color;
+}
+)";
+
+// Instanced shape pipeline (GLSL 3.30 only). Each instance is a quad of
+// size x size; the fragment shader carves the enemy/power-up silhouette out
+// of it and composites the inner layers exactly like sequential alpha blending.
+const GLuint kCornerAttrib = 0;
+const GLuint kInstanceAttrib = 1;
+const GLuint kInstanceColorAttrib = 2;
+const GLuint kInstanceTypeAttrib = 3;
+
+const char* kShapeVertexShader = R"(#version 330
+in vec2 a_corner;
+in vec4 a_instance; // x, y, size, pulse phase
+in vec4 a_color;
+in float a_type;
+uniform mat4 u_projection;
+out vec2 v_local;
+out vec4 v_color;
+flat out int v_type;
+flat out float v_size;
+void main() {
+    int type = int(a_type + 0.5);
+    float size = a_instance.z;
+    if (type == 4) {
+        size *= sin(a_instance.w * 4.0) * 0.3 + 0.7;
+    }
+    v_local = a_corner * size;
+    v_color = a_color;
+    v_type = type;
+    v_size = size;
+    gl_Position = u_projection * vec4(a_instance.xy + v_local, 0.0, 1.0);
+}
+)";
+
+const char* kShapeFragmentShader = R"(#version 330
+in vec2 v_local;
+in vec4 v_color;
+flat in int v_type;
+flat in float v_size;
+out vec4 fragColor;
+
+bool InRect(vec2 p, vec2 minCorner, vec2 maxCorner) {
+    return all(greaterThanEqual(p, minCorner)) && all(lessThan(p, maxCorner));
+}
+
+vec4 Over(vec4 src, vec4 dst) {
+    float a = src.a + dst.a * (1.0 - src.a);
+    if (a <= 0.0) return vec4(0.0);
+    return vec4((src.rgb * src.a + dst.rgb * dst.a * (1.0 - src.a)) / a, a);
+}
+
+void main() {
+    vec2 p = v_local;
+    float s = v_size;
+    vec4 outer = v_color;
+    // Clamped like PackColor clamps the batched fallback's colors
+    vec4 inner = clamp(vec4(outer.rgb + 0.2, outer.a - 0.2), 0.0, 1.0);
+    vec4 result = vec4(0.0);
+
+    if (v_type == 0) {
+        // Error dialog: 1 x 0.75 box with a 2px inset panel
+        if (InRect(p, vec2(-0.5 * s), vec2(0.5 * s, 0.25 * s))) result = outer;
+        if (InRect(p, vec2(-0.5 * s + 2.0), vec2(0.5 * s - 2.0, 0.25 * s - 2.0))) result = Over(inner, result);
+    } else if (v_type == 1) {
+        // Loading circle: two concentric discs
+        float d = length(p);
+        if (d < 0.5 * s) result = outer;
+        if (d < s / 3.0) result = Over(inner, result);
+    } else if (v_type == 2) {
+        // Warning sign: tall panel with a smaller centred highlight
+        if (InRect(p, vec2(-s / 3.0, -0.5 * s), vec2(-s / 3.0 + 0.66 * s, 0.5 * s))) result = outer;
+        if (InRect(p, vec2(-0.25 * s, -s / 3.0), vec2(0.25 * s, -s / 3.0 + 0.66 * s))) result = Over(inner, result);
+    } else if (v_type == 3) {
+        // File icon: tall panel with a 3px inset page
+        if (InRect(p, vec2(-s / 3.0, -0.5 * s), vec2(-s / 3.0 + 0.66 * s, 0.5 * s))) result = outer;
+        if (InRect(p, vec2(-s / 3.0 + 3.0, -0.5 * s + 3.0), vec2(-s / 3.0 + 0.66 * s - 3.0, 0.5 * s - 3.0))) result = Over(inner, result);
+    } else {
+        // Power-up glow: discs at 100%, 80% and 60% of the pulsed radius
+        float d = length(p) / (0.5 * s);
+        if (d < 1.0) result = outer;
+        if (d < 0.8) result = Over(clamp(vec4(outer.rgb + 0.2, outer.a + 0.2), 0.0, 1.0), result);
+        if (d < 0.6) result = Over(clamp(vec4(outer.rgb + vec3(0.1, 0.3, 0.6), outer.a + 0.4), 0.0, 1.0), result);
+    }
+
+    if (result.a <= 0.0) discard;
+    fragColor = result;
+}
+)";
+
+// Textured quad used to composite cached layers. Layer textures hold
+// premultiplied alpha, see BeginLayer.
+const GLuint kLayerPositionAttrib = 0;
+const GLuint kLayerTexCoordAttrib = 1;
+
+const char* kLayerVertexShader330 = R"(#version 330
+in vec2 a_position;
+in vec2 a_texCoord;
+uniform mat4 u_projection;
+out vec2 v_texCoord;
+void main() {
+    v_texCoord = a_texCoord;
+    gl_Position = u_projection * vec4(a_position, 0.0, 1.0);
+}
+)";
+
+const char* kLayerFragmentShader330 = R"(#version 330
+in vec2 v_texCoord;
+uniform sampler2D u_texture;
+out vec4 fragColor;
+void main() {
+    fragColor = texture(u_texture, v_texCoord);
+}
+)";
+
+const char* kLayerVertexShader120 = R"(#version 120
+attribute vec2 a_position;
+attribute vec2 a_texCoord;
+uniform mat4 u_projection;
+varying vec2 v_texCoord;
+void main() {
+    v_texCoord = a_texCoord;
+    gl_Position = u_projection * vec4(a_position, 0.0, 1.0);
+}
+)";
+
+const char* kLayerFragmentShader120 = R"(#version 120
+varying vec2 v_texCoord;
+uniform sampler2D u_texture;
+void main() {
+    gl_FragColor = texture2D(u_texture, v_texCoord);
+}
+)";
+
+GLuint CompileShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint status = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE) {
+        char log[1024];
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        std::cerr << "Shader compilation failed: " << log << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+GLuint LinkProgram(const char* vertexSource, const char* fragmentSource,
+                   const char* const* attributeNames, GLuint attributeCount) {
+    GLuint vertexShader = CompileShader(GL_VERTEX_SHADER, vertexSource);
+    GLuint fragmentShader = CompileShader(GL_FRAGMENT_SHADER, fragmentSource);
+    if (!vertexShader || !fragmentShader) {
+        if (vertexShader) glDeleteShader(vertexShader);
+        if (fragmentShader) glDeleteShader(fragmentShader);
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    for (GLuint i = 0; i < attributeCount; ++i) {
+        glBindAttribLocation(program, i, attributeNames[i]);
+    }
+    glLinkProgram(program);
+
+    // Shaders are owned by the program once linked
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        char log[1024];
+        glGetProgramInfoLog(program, sizeof(log), nullptr, log);
+        std::cerr << "Shader program link failed: " << log << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+} // namespace
 
 bool Renderer::Initialize() {
     std::cout << "Renderer initialized" << std::endl;
-    
+
     // Check OpenGL version
     const char* version = (const char*)glGetString(GL_VERSION);
     std::cout << "OpenGL Version: " << (version ? version : "Unknown") << std::endl;
-    
+
     // Set up OpenGL state for 2D rendering
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    
-    // Set up 2D projection matrix (works with both OpenGL 2.1 and 3.3+)
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    
-    // Use glOrtho for 2D projection - screen coordinates: (0,0) top-left, (1280,720) bottom-right
-    glOrtho(0.0, 1280.0, 720.0, 0.0, -1.0, 1.0);
-    
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
-    
-    // Enable vertex arrays for immediate mode
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glEnableClientState(GL_COLOR_ARRAY);
-    
+
+    // Use GLSL 3.30 with a VAO on 3.3+ contexts, GLSL 1.20 on the 2.1 fallback
+    bool useGLSL330 = GLEW_VERSION_3_3;
+    if (!CreateShaderProgram(useGLSL330)) {
+        std::cerr << "Failed to create renderer shader program!" << std::endl;
+        return false;
+    }
+
+    glGenBuffers(1, &m_vbo);
+
+    m_useVertexArrayObject = useGLSL330;
+    if (m_useVertexArrayObject) {
+        glGenVertexArrays(1, &m_vao);
+        glBindVertexArray(m_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+        glEnableVertexAttribArray(kPositionAttrib);
+        glEnableVertexAttribArray(kColorAttrib);
+        glVertexAttribPointer(kPositionAttrib, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, x));
+        glVertexAttribPointer(kColorAttrib, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    // glDrawArraysInstanced/glVertexAttribDivisor are core in 3.3; the 2.1
+    // context falls back to expanding shapes into the batch
+    m_supportsInstancing = useGLSL330 && CreateShapePipeline();
+    if (!m_supportsInstancing) {
+        std::cout << "Instanced shapes unavailable, using batched fallback" << std::endl;
+    }
+
+    // Framebuffer objects are core in 3.0 and available on 2.1 through ARB_framebuffer_object
+    m_supportsLayers = (GLEW_VERSION_3_0 || GLEW_ARB_framebuffer_object) && CreateLayerPipeline(useGLSL330);
+    if (!m_supportsLayers) {
+        std::cout << "Framebuffer objects unavailable, static layers drawn every frame" << std::endl;
+    }
+
+    // Until the first BeginFrame: (0,0) top-left, (1280,720) bottom-right
+    SetOrthoProjection(0.0f, m_worldWidth, m_worldHeight, 0.0f);
+
+    // Enough for a crowded frame without reallocating
+    m_vertices.reserve(64 * 1024);
+
     m_initialized = true;
     return true;
 }
 
 void Renderer::Shutdown() {
+    if (m_vao) {
+        glDeleteVertexArrays(1, &m_vao);
+        m_vao = 0;
+    }
+    if (m_vbo) {
+        glDeleteBuffers(1, &m_vbo);
+        m_vbo = 0;
+    }
+    if (m_program) {
+        glDeleteProgram(m_program);
+        m_program = 0;
+    }
+    if (m_shapeVao) {
+        glDeleteVertexArrays(1, &m_shapeVao);
+        m_shapeVao = 0;
+    }
+    if (m_quadVbo) {
+        glDeleteBuffers(1, &m_quadVbo);
+        m_quadVbo = 0;
+    }
+    if (m_instanceVbo) {
+        glDeleteBuffers(1, &m_instanceVbo);
+        m_instanceVbo = 0;
+    }
+    if (m_shapeProgram) {
+        glDeleteProgram(m_shapeProgram);
+        m_shapeProgram = 0;
+    }
+    for (auto& cache : m_layers) {
+        ReleaseLayer(cache);
+    }
+    if (m_layerVao) {
+        glDeleteVertexArrays(1, &m_layerVao);
+        m_layerVao = 0;
+    }
+    if (m_layerVbo) {
+        glDeleteBuffers(1, &m_layerVbo);
+        m_layerVbo = 0;
+    }
+    if (m_layerProgram) {
+        glDeleteProgram(m_layerProgram);
+        m_layerProgram = 0;
+    }
+    ReleaseLayer(m_sceneTarget);
+    m_sceneScaled = false;
+    m_supportsLayers = false;
+    m_activeLayer = -1;
+    for (auto& instances : m_instances) {
+        instances.clear();
+    }
+    m_pendingInstances = 0;
+    m_instanceVboCapacity = 0;
+    m_supportsInstancing = false;
+    m_vertices.clear();
+    m_vboCapacity = 0;
     m_initialized = false;
     std::cout << "Renderer shutdown" << std::endl;
 }
 
 void Renderer::Clear() {
+    // Anything batched before the clear would otherwise be drawn on top of it
+    m_vertices.clear();
+    for (auto& instances : m_instances) {
+        instances.clear();
+    }
+    m_pendingInstances = 0;
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
@@ -46,31 +366,499 @@ void Renderer::Present() {
     // SDL_GL_SwapWindow is called in Game.cpp
 }
 
+void Renderer::BeginFrame(const Viewport& viewport) {
+    if (!m_initialized) return;
+
+    m_worldWidth = viewport.GetWorldWidth();
+    m_worldHeight = viewport.GetWorldHeight();
+    m_windowWidth = viewport.GetWindowWidth();
+    m_windowHeight = viewport.GetWindowHeight();
+    for (int i = 0; i < 16; ++i) m_projection[i] = viewport.GetProjection()[i];
+
+    int renderWidth = viewport.GetRenderWidth();
+    int renderHeight = viewport.GetRenderHeight();
+
+    // Render below window resolution into an offscreen target when scaled
+    m_sceneScaled = viewport.IsScaled() && m_supportsLayers &&
+                    PrepareTarget(m_sceneTarget, renderWidth, renderHeight, true);
+    if (!m_sceneScaled) {
+        // Without framebuffer objects the window is the only target
+        if (m_supportsLayers) {
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        }
+        renderWidth = m_windowWidth;
+        renderHeight = m_windowHeight;
+    }
+
+    m_pixelsPerUnit = renderHeight / m_worldHeight;
+    glViewport(0, 0, renderWidth, renderHeight);
+}
+
+void Renderer::EndFrame() {
+    if (!m_initialized) return;
+
+    Flush();
+
+    glViewport(0, 0, m_windowWidth, m_windowHeight);
+    if (!m_sceneScaled) return;
+
+    // Upscale the low-resolution scene to the window with linear filtering
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDisable(GL_BLEND);
+    DrawTexturedQuad(m_sceneTarget.texture, 0.0f, 0.0f, m_worldWidth, m_worldHeight);
+    glEnable(GL_BLEND);
+}
+
+void Renderer::Flush() {
+    // Submission order keeps at most one of these non-empty, see DrawShape
+    FlushBatch();
+    FlushInstances();
+}
+
+void Renderer::FlushBatch() {
+    if (!m_initialized || m_vertices.empty()) return;
+
+    glUseProgram(m_program);
+    glUniformMatrix4fv(m_projectionLocation, 1, GL_FALSE, m_projection);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+
+    // Orphan the previous frame's storage so the driver never stalls on it
+    size_t bytes = m_vertices.size() * sizeof(Vertex);
+    if (bytes > m_vboCapacity) {
+        m_vboCapacity = bytes;
+    }
+    glBufferData(GL_ARRAY_BUFFER, m_vboCapacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, m_vertices.data());
+
+    if (m_useVertexArrayObject) {
+        glBindVertexArray(m_vao);
+    } else {
+        glEnableVertexAttribArray(kPositionAttrib);
+        glEnableVertexAttribArray(kColorAttrib);
+        glVertexAttribPointer(kPositionAttrib, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, x));
+        glVertexAttribPointer(kColorAttrib, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+    }
+
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertices.size()));
+
+    // Leave no client state behind for ImGui's backend
+    if (m_useVertexArrayObject) {
+        glBindVertexArray(0);
+    } else {
+        glDisableVertexAttribArray(kPositionAttrib);
+        glDisableVertexAttribArray(kColorAttrib);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glUseProgram(0);
+
+    m_vertices.clear();
+}
+
+void Renderer::FlushInstances() {
+    if (!m_initialized || m_pendingInstances == 0) return;
+
+    glUseProgram(m_shapeProgram);
+    glUniformMatrix4fv(m_shapeProjectionLocation, 1, GL_FALSE, m_projection);
+
+    // One orphaned upload holding every type back to back
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVbo);
+    size_t bytes = m_pendingInstances * sizeof(ShapeInstance);
+    if (bytes > m_instanceVboCapacity) {
+        m_instanceVboCapacity = bytes;
+    }
+    glBufferData(GL_ARRAY_BUFFER, m_instanceVboCapacity, nullptr, GL_STREAM_DRAW);
+
+    size_t offset = 0;
+    size_t typeOffsets[kShapeTypeCount];
+    for (int type = 0; type < kShapeTypeCount; ++type) {
+        typeOffsets[type] = offset;
+        size_t typeBytes = m_instances[type].size() * sizeof(ShapeInstance);
+        if (typeBytes > 0) {
+            glBufferSubData(GL_ARRAY_BUFFER, offset, typeBytes, m_instances[type].data());
+        }
+        offset += typeBytes;
+    }
+
+    glBindVertexArray(m_shapeVao);
+    for (int type = 0; type < kShapeTypeCount; ++type) {
+        GLsizei count = static_cast<GLsizei>(m_instances[type].size());
+        if (count == 0) continue;
+
+        const char* base = reinterpret_cast<const char*>(typeOffsets[type]);
+        glVertexAttribPointer(kInstanceAttrib, 4, GL_FLOAT, GL_FALSE, sizeof(ShapeInstance),
+                              base + offsetof(ShapeInstance, x));
+        glVertexAttribPointer(kInstanceColorAttrib, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ShapeInstance),
+                              base + offsetof(ShapeInstance, color));
+        glVertexAttribPointer(kInstanceTypeAttrib, 1, GL_FLOAT, GL_FALSE, sizeof(ShapeInstance),
+                              base + offsetof(ShapeInstance, type));
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count);
+
+        m_instances[type].clear();
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glUseProgram(0);
+
+    m_pendingInstances = 0;
+}
+
+bool Renderer::BeginLayer(RenderLayer layer, float x, float y, float width, float height) {
+    if (!m_initialized) return false;
+    if (!m_supportsLayers) return true;
+
+    LayerCache& cache = m_layers[static_cast<int>(layer)];
+    if (cache.valid && cache.x == x && cache.y == y && cache.width == width && cache.height == height) {
+        return false;
+    }
+    if (m_activeLayer >= 0) {
+        std::cerr << "Renderer::BeginLayer called while another layer is active" << std::endl;
+        return true;
+    }
+
+    // Everything submitted so far belongs to the current target
+    Flush();
+
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &m_savedFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, m_savedViewport);
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, m_savedClearColor);
+    for (int i = 0; i < 16; ++i) m_savedProjection[i] = m_projection[i];
+
+    // Match the current pixels-per-unit so the cached copy blits 1:1
+    int textureWidth = static_cast<int>(width * m_pixelsPerUnit + 0.5f);
+    int textureHeight = static_cast<int>(height * m_pixelsPerUnit + 0.5f);
+    if (!PrepareTarget(cache, textureWidth, textureHeight, false)) {
+        std::cerr << "Layer framebuffer incomplete, drawing layer directly" << std::endl;
+        glBindFramebuffer(GL_FRAMEBUFFER, m_savedFramebuffer);
+        return true;
+    }
+
+    cache.x = x;
+    cache.y = y;
+    cache.width = width;
+    cache.height = height;
+    m_activeLayer = static_cast<int>(layer);
+
+    glViewport(0, 0, cache.textureWidth, cache.textureHeight);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    SetOrthoProjection(x, x + width, y + height, y);
+
+    // Accumulate premultiplied alpha so compositing matches drawing directly
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    return true;
+}
+
+void Renderer::EndLayer() {
+    if (m_activeLayer < 0) return;
+
+    Flush();
+
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_savedFramebuffer);
+    glViewport(m_savedViewport[0], m_savedViewport[1], m_savedViewport[2], m_savedViewport[3]);
+    glClearColor(m_savedClearColor[0], m_savedClearColor[1], m_savedClearColor[2], m_savedClearColor[3]);
+    for (int i = 0; i < 16; ++i) m_projection[i] = m_savedProjection[i];
+
+    m_layers[m_activeLayer].valid = true;
+    m_activeLayer = -1;
+}
+
+void Renderer::DrawLayer(RenderLayer layer) {
+    if (!m_initialized || !m_supportsLayers) return;
+
+    const LayerCache& cache = m_layers[static_cast<int>(layer)];
+    if (!cache.valid) return;
+
+    // Keep submission order with anything batched before the layer
+    Flush();
+
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    DrawTexturedQuad(cache.texture, cache.x, cache.y, cache.width, cache.height);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void Renderer::InvalidateLayers() {
+    // Storage is kept and reallocated lazily if the size changed
+    for (auto& cache : m_layers) {
+        cache.valid = false;
+    }
+}
+
+void Renderer::DrawTexturedQuad(unsigned int texture, float x, float y, float width, float height) {
+    // Render-to-texture is bottom-up, so the top edge samples v = 1
+    float x2 = x + width;
+    float y2 = y + height;
+    const float quad[] = {
+        x,  y,  0.0f, 1.0f,
+        x2, y,  1.0f, 1.0f,
+        x,  y2, 0.0f, 0.0f,
+        x2, y2, 1.0f, 0.0f,
+    };
+
+    glUseProgram(m_layerProgram);
+    glUniformMatrix4fv(m_layerProjectionLocation, 1, GL_FALSE, m_projection);
+    glUniform1i(m_layerTextureLocation, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_layerVbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STREAM_DRAW);
+    if (m_layerVao) {
+        glBindVertexArray(m_layerVao);
+    } else {
+        glEnableVertexAttribArray(kLayerPositionAttrib);
+        glEnableVertexAttribArray(kLayerTexCoordAttrib);
+        glVertexAttribPointer(kLayerPositionAttrib, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+        glVertexAttribPointer(kLayerTexCoordAttrib, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+    }
+
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+    if (m_layerVao) {
+        glBindVertexArray(0);
+    } else {
+        glDisableVertexAttribArray(kLayerPositionAttrib);
+        glDisableVertexAttribArray(kLayerTexCoordAttrib);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(0);
+}
+
+bool Renderer::PrepareTarget(LayerCache& cache, int width, int height, bool linearFilter) {
+    if (width < 1) width = 1;
+    if (height < 1) height = 1;
+
+    if (cache.framebuffer && cache.textureWidth == width && cache.textureHeight == height) {
+        glBindFramebuffer(GL_FRAMEBUFFER, cache.framebuffer);
+        return true;
+    }
+
+    ReleaseLayer(cache);
+
+    GLint filter = linearFilter ? GL_LINEAR : GL_NEAREST;
+    glGenTextures(1, &cache.texture);
+    glBindTexture(GL_TEXTURE_2D, cache.texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &cache.framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, cache.framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, cache.texture, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        ReleaseLayer(cache);
+        return false;
+    }
+
+    cache.textureWidth = width;
+    cache.textureHeight = height;
+    return true;
+}
+
+void Renderer::ReleaseLayer(LayerCache& cache) {
+    if (cache.framebuffer) {
+        glDeleteFramebuffers(1, &cache.framebuffer);
+        cache.framebuffer = 0;
+    }
+    if (cache.texture) {
+        glDeleteTextures(1, &cache.texture);
+        cache.texture = 0;
+    }
+    cache.textureWidth = 0;
+    cache.textureHeight = 0;
+    cache.valid = false;
+}
+
 void Renderer::DrawRect(float x, float y, float width, float height, float r, float g, float b, float a) {
     if (!m_initialized) return;
-    
-    glColor4f(r, g, b, a);
-    glBegin(GL_QUADS);
-    glVertex2f(x, y);
-    glVertex2f(x + width, y);
-    glVertex2f(x + width, y + height);
-    glVertex2f(x, y + height);
-    glEnd();
+
+    // Shapes submitted earlier must land underneath this primitive
+    FlushInstances();
+
+    uint32_t color = PackColor(r, g, b, a);
+    float x2 = x + width;
+    float y2 = y + height;
+
+    // Two triangles per quad
+    m_vertices.push_back({x, y, color});
+    m_vertices.push_back({x2, y, color});
+    m_vertices.push_back({x2, y2, color});
+    m_vertices.push_back({x, y, color});
+    m_vertices.push_back({x2, y2, color});
+    m_vertices.push_back({x, y2, color});
 }
 
 void Renderer::DrawCircle(float x, float y, float radius, float r, float g, float b, float a) {
     if (!m_initialized) return;
-    
-    const int segments = 32;
-    const float angleStep = 2.0f * M_PI / segments;
-    
-    glColor4f(r, g, b, a);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex2f(x, y); // Center
-    
-    for (int i = 0; i <= segments; ++i) {
-        float angle = i * angleStep;
-        glVertex2f(x + cos(angle) * radius, y + sin(angle) * radius);
-    }
-    glEnd();
-} 
\ No newline at end of file
+
+    FlushInstances();
+
+    const int segments = CircleMesh::SegmentsForRadius(radius * m_pixelsPerUnit);
+
+    size_t base = m_vertices.size();
+    m_vertices.resize(base + segments * 3);
+    CircleMesh::WriteTriangles(m_vertices.data() + base, segments, x, y, radius, PackColor(r, g, b, a));
+}
+
+void Renderer::DrawShape(ShapeType type, float x, float y, float size, float r, float g, float b, float a,
+                         float pulsePhase) {
+    if (!m_initialized) return;
+
+    if (!m_supportsInstancing) {
+        DrawShapeBatched(type, x, y, size, r, g, b, a, pulsePhase);
+        return;
+    }
+
+    // Primitives batched earlier must land underneath this shape
+    FlushBatch();
+
+    int typeIndex = static_cast<int>(type);
+    m_instances[typeIndex].push_back({x, y, size, pulsePhase, PackColor(r, g, b, a), static_cast<float>(typeIndex)});
+    ++m_pendingInstances;
+}
+
+void Renderer::DrawShapeBatched(ShapeType type, float x, float y, float size, float r, float g, float b, float a,
+                                float pulsePhase) {
+    // Mirrors kShapeFragmentShader layer for layer
+    float ir = std::min(r + 0.2f, 1.0f);
+    float ig = std::min(g + 0.2f, 1.0f);
+    float ib = std::min(b + 0.2f, 1.0f);
+    float ia = a - 0.2f;
+
+    switch (type) {
+        case ShapeType::ErrorDialog:
+            DrawRect(x - size/2, y - size/2, size, size * 0.75f, r, g, b, a);
+            DrawRect(x - size/2 + 2, y - size/2 + 2, size - 4, size * 0.75f - 4, ir, ig, ib, ia);
+            break;
+        case ShapeType::LoadingCircle:
+            DrawCircle(x, y, size/2, r, g, b, a);
+            DrawCircle(x, y, size/3, ir, ig, ib, ia);
+            break;
+        case ShapeType::WarningTriangle:
+            DrawRect(x - size/3, y - size/2, size * 0.66f, size, r, g, b, a);
+            DrawRect(x - size/4, y - size/3, size * 0.5f, size * 0.66f, ir, ig, ib, ia);
+            break;
+        case ShapeType::FileIcon:
+            DrawRect(x - size/3, y - size/2, size * 0.66f, size, r, g, b, a);
+            DrawRect(x - size/3 + 3, y - size/2 + 3, size * 0.66f - 6, size - 6, ir, ig, ib, ia);
+            break;
+        case ShapeType::PowerUpGlow: {
+            float radius = size/2 * (std::sin(pulsePhase * 4.0f) * 0.3f + 0.7f);
+            DrawCircle(x, y, radius, r, g, b, a);
+            DrawCircle(x, y, radius * 0.8f, ir, ig, ib, a + 0.2f);
+            DrawCircle(x, y, radius * 0.6f, std::min(r + 0.1f, 1.0f), std::min(g + 0.3f, 1.0f),
+                       std::min(b + 0.6f, 1.0f), a + 0.4f);
+            break;
+        }
+        case ShapeType::Count:
+            break;
+    }
+}
+
+bool Renderer::CreateShaderProgram(bool useGLSL330) {
+    const char* attributes[] = {"a_position", "a_color"};
+    m_program = LinkProgram(useGLSL330 ? kVertexShader330 : kVertexShader120,
+                            useGLSL330 ? kFragmentShader330 : kFragmentShader120,
+                            attributes, 2);
+    if (!m_program) {
+        return false;
+    }
+
+    m_projectionLocation = glGetUniformLocation(m_program, "u_projection");
+    std::cout << "Renderer using " << (useGLSL330 ? "GLSL 3.30" : "GLSL 1.20") << " batch shader" << std::endl;
+    return true;
+}
+
+bool Renderer::CreateShapePipeline() {
+    const char* attributes[] = {"a_corner", "a_instance", "a_color", "a_type"};
+    m_shapeProgram = LinkProgram(kShapeVertexShader, kShapeFragmentShader, attributes, 4);
+    if (!m_shapeProgram) {
+        return false;
+    }
+    m_shapeProjectionLocation = glGetUniformLocation(m_shapeProgram, "u_projection");
+
+    // Unit quad drawn as a triangle strip, centred on the instance position
+    const float corners[] = {
+        -0.5f, -0.5f,
+         0.5f, -0.5f,
+        -0.5f,  0.5f,
+         0.5f,  0.5f,
+    };
+    glGenBuffers(1, &m_quadVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, m_quadVbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+
+    glGenBuffers(1, &m_instanceVbo);
+
+    glGenVertexArrays(1, &m_shapeVao);
+    glBindVertexArray(m_shapeVao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_quadVbo);
+    glEnableVertexAttribArray(kCornerAttrib);
+    glVertexAttribPointer(kCornerAttrib, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+
+    // Instance attributes advance once per quad; their offsets are re-pointed
+    // per shape type in FlushInstances
+    glEnableVertexAttribArray(kInstanceAttrib);
+    glEnableVertexAttribArray(kInstanceColorAttrib);
+    glEnableVertexAttribArray(kInstanceTypeAttrib);
+    glVertexAttribDivisor(kInstanceAttrib, 1);
+    glVertexAttribDivisor(kInstanceColorAttrib, 1);
+    glVertexAttribDivisor(kInstanceTypeAttrib, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    std::cout << "Renderer using instanced shape pipeline" << std::endl;
+    return true;
+}
+
+bool Renderer::CreateLayerPipeline(bool useGLSL330) {
+    const char* attributes[] = {"a_position", "a_texCoord"};
+    m_layerProgram = LinkProgram(useGLSL330 ? kLayerVertexShader330 : kLayerVertexShader120,
+                                 useGLSL330 ? kLayerFragmentShader330 : kLayerFragmentShader120,
+                                 attributes, 2);
+    if (!m_layerProgram) {
+        return false;
+    }
+    m_layerProjectionLocation = glGetUniformLocation(m_layerProgram, "u_projection");
+    m_layerTextureLocation = glGetUniformLocation(m_layerProgram, "u_texture");
+
+    glGenBuffers(1, &m_layerVbo);
+    if (m_useVertexArrayObject) {
+        glGenVertexArrays(1, &m_layerVao);
+        glBindVertexArray(m_layerVao);
+        glBindBuffer(GL_ARRAY_BUFFER, m_layerVbo);
+        glEnableVertexAttribArray(kLayerPositionAttrib);
+        glEnableVertexAttribArray(kLayerTexCoordAttrib);
+        glVertexAttribPointer(kLayerPositionAttrib, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+        glVertexAttribPointer(kLayerTexCoordAttrib, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    return true;
+}
+
+void Renderer::SetOrthoProjection(float left, float right, float bottom, float top) {
+    // Same matrix glOrtho would build with near=-1, far=1
+    for (float& value : m_projection) value = 0.0f;
+    m_projection[0] = 2.0f / (right - left);
+    m_projection[5] = 2.0f / (top - bottom);
+    m_projection[10] = -1.0f;
+    m_projection[12] = -(right + left) / (right - left);
+    m_projection[13] = -(top + bottom) / (top - bottom);
+    m_projection[15] = 1.0f;
+}
+
+uint32_t Renderer::PackColor(float r, float g, float b, float a) {
+    auto toByte = [](float v) -> uint32_t {
+        v = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+        return static_cast<uint32_t>(v * 255.0f + 0.5f);
+    };
+    // Byte order in memory is R, G, B, A on little-endian targets
+    return toByte(r) | (toByte(g) << 8) | (toByte(b) << 16) | (toByte(a) << 24);
+}
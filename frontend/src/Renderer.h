@@ -1,5 +1,31 @@
 #pragma once
 
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class Viewport;
+
+// Composite shapes drawn through the instanced path. Their geometry lives in
+// the shape shader; without instancing they expand into batched rects/circles.
+enum class ShapeType {
+    ErrorDialog,
+    LoadingCircle,
+    WarningTriangle,
+    FileIcon,
+    PowerUpGlow,
+    Count
+};
+
+// Static layers cached in framebuffer objects. They are rendered once and
+// then composited as a single textured quad until InvalidateLayers().
+enum class RenderLayer {
+    PlayBackground,
+    PlayTaskbar,
+    HomeBackdrop,
+    Count
+};
+
 class Renderer {
 public:
     Renderer() = default;
@@ -7,14 +33,133 @@ public:
 
     bool Initialize();
     void Shutdown();
-    
+
     void Clear();
     void Present();
-    
+
+    // Frame bracket: BeginFrame takes projection and pixel density from the
+    // viewport and, at render scale < 1, redirects drawing into a smaller
+    // offscreen target that EndFrame upscales to the window.
+    void BeginFrame(const Viewport& viewport);
+    void EndFrame();
+
+    // Submit all batched primitives to the GPU (called once per frame by Game)
+    void Flush();
+
     // Basic rendering methods
     void DrawRect(float x, float y, float width, float height, float r, float g, float b, float a = 1.0f);
     void DrawCircle(float x, float y, float radius, float r, float g, float b, float a = 1.0f);
 
+    // Instanced shape drawing: size is the shape's full extent, color is the
+    // outer layer (inner layers are derived in the shader)
+    void DrawShape(ShapeType type, float x, float y, float size, float r, float g, float b, float a = 1.0f,
+                   float pulsePhase = 0.0f);
+    bool IsInstancingSupported() const { return m_supportsInstancing; }
+
+    // Layer cache: BeginLayer returns true when the layer has to be redrawn,
+    // in which case draw calls up to EndLayer() go into it. Without FBO
+    // support it always returns true and drawing goes straight to the screen.
+    bool BeginLayer(RenderLayer layer, float x, float y, float width, float height);
+    void EndLayer();
+    void DrawLayer(RenderLayer layer);
+    void InvalidateLayers();
+
+    float GetWorldWidth() const { return m_worldWidth; }
+    float GetWorldHeight() const { return m_worldHeight; }
+
 private:
+    // Interleaved vertex layout streamed to the VBO (12 bytes per vertex)
+    struct Vertex {
+        float x, y;
+        uint32_t color; // RGBA8, normalized in the shader
+    };
+
+    // Per-instance attributes for the shape shader (24 bytes per instance)
+    struct ShapeInstance {
+        float x, y;
+        float size;
+        float pulsePhase;
+        uint32_t color;
+        float type;
+    };
+
+    static constexpr int kShapeTypeCount = static_cast<int>(ShapeType::Count);
+    static constexpr int kLayerCount = static_cast<int>(RenderLayer::Count);
+
+    struct LayerCache {
+        unsigned int framebuffer = 0;
+        unsigned int texture = 0;
+        int textureWidth = 0;
+        int textureHeight = 0;
+        float x = 0.0f, y = 0.0f;
+        float width = 0.0f, height = 0.0f;
+        bool valid = false;
+    };
+
     bool m_initialized = false;
-}; 
\ No newline at end of file
+    bool m_useVertexArrayObject = false;
+    bool m_supportsInstancing = false;
+    bool m_supportsLayers = false;
+
+    // GL objects
+    unsigned int m_program = 0;
+    unsigned int m_vbo = 0;
+    unsigned int m_vao = 0;
+    int m_projectionLocation = -1;
+    size_t m_vboCapacity = 0;
+
+    unsigned int m_shapeProgram = 0;
+    unsigned int m_shapeVao = 0;
+    unsigned int m_quadVbo = 0;
+    unsigned int m_instanceVbo = 0;
+    int m_shapeProjectionLocation = -1;
+    size_t m_instanceVboCapacity = 0;
+
+    unsigned int m_layerProgram = 0;
+    unsigned int m_layerVao = 0;
+    unsigned int m_layerVbo = 0;
+    int m_layerProjectionLocation = -1;
+    int m_layerTextureLocation = -1;
+
+    // Layer cache state
+    LayerCache m_layers[kLayerCount];
+    int m_activeLayer = -1;
+    int m_savedFramebuffer = 0;
+    int m_savedViewport[4] = {};
+    float m_savedClearColor[4] = {};
+    float m_savedProjection[16] = {};
+
+    // World size the projection maps onto and render pixels per world unit
+    float m_worldWidth = 1280.0f;
+    float m_worldHeight = 720.0f;
+    float m_pixelsPerUnit = 1.0f;
+
+    // Offscreen target used when rendering below window resolution
+    LayerCache m_sceneTarget;
+    bool m_sceneScaled = false;
+    int m_windowWidth = 0;
+    int m_windowHeight = 0;
+
+    // Projection matrix (column-major orthographic)
+    float m_projection[16] = {};
+
+    // CPU-side batch, rebuilt every frame
+    std::vector<Vertex> m_vertices;
+
+    // Pending shape instances, grouped by type so each type is one draw call
+    std::vector<ShapeInstance> m_instances[kShapeTypeCount];
+    size_t m_pendingInstances = 0;
+
+    bool CreateShaderProgram(bool useGLSL330);
+    bool CreateShapePipeline();
+    bool CreateLayerPipeline(bool useGLSL330);
+    void ReleaseLayer(LayerCache& cache);
+    bool PrepareTarget(LayerCache& cache, int width, int height, bool linearFilter);
+    void DrawTexturedQuad(unsigned int texture, float x, float y, float width, float height);
+    void FlushBatch();
+    void FlushInstances();
+    void DrawShapeBatched(ShapeType type, float x, float y, float size, float r, float g, float b, float a,
+                          float pulsePhase);
+    void SetOrthoProjection(float left, float right, float bottom, float top);
+    static uint32_t PackColor(float r, float g, float b, float a);
+};
@@ -0,0 +1,535 @@
+#include "SessionJournal.h"
+#include "AuthNetworkManager.h"
+#include "Random.h"
+#include "WireFormat.h"
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+
+#if defined(_WIN32)
+#include <io.h>
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+using json = nlohmann::json;
+
+namespace {
+// How long the writer collects appends before one write + fsync
+constexpr std::chrono::milliseconds kWriteBatchWindow(200);
+
+// Rewrite the file once it holds this many superseded lines
+constexpr size_t kCompactThreshold = 256;
+
+// Retry delays for failed uploads
+constexpr double kFirstRetryDelay = 1.0;
+constexpr double kMaxRetryDelay = 60.0;
+
+// How long the writer waits before retrying a failed compaction
+constexpr std::chrono::seconds kRewriteRetryDelay(5);
+
+double Now() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+std::string ToHex(uint64_t value) {
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(value));
+    return hex;
+}
+
+json ProgressToJson(const ProgressSnapshot& progress) {
+    return json{
+        { "score", progress.score },
+        { "leaderboardPoints", progress.leaderboardPoints },
+        { "skillPoints", progress.skillPoints },
+        { "survivalTime", progress.survivalTime },
+        { "livesRemaining", progress.livesRemaining }
+    };
+}
+
+ProgressSnapshot ProgressFromJson(const json& record) {
+    ProgressSnapshot progress;
+    progress.score = record.value("score", 0);
+    progress.leaderboardPoints = record.value("leaderboardPoints", 0);
+    progress.skillPoints = record.value("skillPoints", 0);
+    progress.survivalTime = record.value("survivalTime", 0.0f);
+    progress.livesRemaining = record.value("livesRemaining", 0);
+    return progress;
+}
+
+bool SyncFile(FILE* file) {
+    if (std::fflush(file) != 0) return false;
+#if defined(_WIN32)
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+// Atomically replaces 'to'; std::rename won't overwrite on Windows
+bool ReplaceJournalFile(const std::string& from, const std::string& to) {
+#if defined(_WIN32)
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+// A rejected request won't succeed on retry; anything else (no
+// connection, timeouts, server errors) might. 424 is an event whose
+// session start failed earlier in its batch. 401 and 403 mean the token
+// expired, and the next sign-in brings a fresh one.
+bool IsPermanentFailure(const HttpResponse& response) {
+    int status = response.statusCode;
+    return status >= 400 && status < 500 && status != 401 && status != 403 &&
+           status != 408 && status != 424 && status != 429;
+}
+}
+
+SessionJournal::SessionJournal(HttpClient* client)
+    : m_network(std::make_unique<AuthNetworkManager>(client))
+    , m_recordCount(0)
+    , m_rewritePending(false)
+    , m_writerRunning(false)
+{
+}
+
+SessionJournal::~SessionJournal() {
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        m_writerRunning = false;
+    }
+    m_writeReady.notify_all();
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+}
+
+bool SessionJournal::Open(const std::string& path) {
+    m_path = path;
+    Load();
+
+    // A run cut short (quit mid-game, crash) ends with its last progress
+    for (Session& session : m_sessions) {
+        if (!session.ended) {
+            session.result = SessionResult();
+            session.result.progress = session.progress;
+            session.ended = true;
+        }
+    }
+
+    if (!m_sessions.empty()) {
+        std::cout << "Session journal: " << m_sessions.size() << " session(s) waiting for upload" << std::endl;
+    }
+
+    m_writerRunning = true;
+    try {
+        m_writer = std::thread(&SessionJournal::WriterLoop, this);
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to start session journal writer: " << e.what() << std::endl;
+        m_writerRunning = false;
+        m_path.clear();
+        return false;
+    }
+
+    // Drop what the last run finished, or superseded progress
+    if (m_recordCount > 0) {
+        Compact();
+    }
+    return true;
+}
+
+void SessionJournal::SetBaseUrl(const std::string& baseUrl) {
+    m_network->SetBaseUrl(baseUrl);
+}
+
+void SessionJournal::SetTimeout(int timeoutMs) {
+    m_network->SetTimeout(timeoutMs);
+}
+
+void SessionJournal::SetWireFormat(WireFormat format) {
+    m_network->SetWireFormat(format);
+}
+
+void SessionJournal::SetUser(const std::string& userId, const std::string& authToken) {
+    m_userId = userId;
+    m_network->SetAuthToken(authToken);
+
+    // A fresh token may be what the waiting sessions were missing
+    for (Session& session : m_sessions) {
+        if (session.userId == m_userId) {
+            session.backoff = 0.0;
+            session.retryAt = 0.0;
+        }
+    }
+}
+
+std::string SessionJournal::BeginSession(uint64_t seed) {
+    if (m_userId.empty()) {
+        std::cout << "Not signed in - game session won't be recorded" << std::endl;
+        return std::string();
+    }
+
+    Session session;
+    session.localId = ToHex(Random::GenerateSeed());
+    session.seed = seed;
+    session.userId = m_userId;
+    m_sessions.push_back(session);
+
+    Append(json{ { "event", "start" }, { "id", session.localId }, { "seed", ToHex(seed) },
+                 { "user", m_userId } }.dump());
+    return session.localId;
+}
+
+void SessionJournal::RecordProgress(const std::string& localId, const ProgressSnapshot& progress) {
+    Session* session = FindSession(localId);
+    if (!session || session->ended) return;
+
+    session->progress = progress;
+    session->hasProgress = true;
+    session->progressSent = false;
+
+    json record = ProgressToJson(progress);
+    record["event"] = "progress";
+    record["id"] = localId;
+    Append(record.dump());
+}
+
+void SessionJournal::RecordEnd(const std::string& localId, const SessionResult& result) {
+    Session* session = FindSession(localId);
+    if (!session || session->ended) return;
+
+    session->result = result;
+    session->ended = true;
+
+    // The final numbers go with session/end; a save still waiting for its
+    // batch would only be overwritten
+    if (session->progressEvent != 0) {
+        m_network->CancelQueuedEvent(session->progressEvent);
+    }
+
+    json record = ProgressToJson(result.progress);
+    record["event"] = "end";
+    record["id"] = localId;
+    record["kills"] = result.kills;
+    record["damageDealt"] = result.damageDealt;
+    record["damageTaken"] = result.damageTaken;
+    record["waveReached"] = result.waveReached;
+    Append(record.dump());
+}
+
+void SessionJournal::Update() {
+    double now = Now();
+    for (Session& session : m_sessions) {
+        if (session.userId == m_userId && session.uploadsInFlight == 0 && now >= session.retryAt) {
+            StartUpload(session, now);
+        }
+    }
+    m_network->UpdateBatch();
+}
+
+void SessionJournal::StartUpload(Session& session, double now) {
+    bool sendStart = session.serverId.empty();
+    bool sendProgress = !session.ended && session.hasProgress && !session.progressSent &&
+                        now >= session.nextProgressAt;
+    if (!sendStart && !session.ended && !sendProgress) return;
+
+    std::string localId = session.localId;
+    auto callbackFor = [this, localId](Upload upload) -> HttpCallback {
+        return [this, localId, upload](const HttpResponse& response) {
+            FinishUpload(localId, upload, response);
+        };
+    };
+
+    // Without a server id, later events find the session by its local id
+    std::string sessionRef;
+    if (sendStart) {
+        sessionRef = localId;
+        session.uploadsInFlight++;
+        m_network->QueueSessionStart(session.seed, sessionRef, callbackFor(Upload::Start));
+    }
+
+    if (session.ended) {
+        const SessionResult& result = session.result;
+        session.uploadsInFlight++;
+        m_network->QueueSessionEnd(session.serverId, sessionRef, result.progress.score,
+            result.progress.leaderboardPoints, result.progress.skillPoints,
+            result.progress.survivalTime, result.kills, result.damageDealt,
+            result.damageTaken, result.waveReached, callbackFor(Upload::End));
+    } else if (sendProgress) {
+        const ProgressSnapshot& progress = session.progress;
+        session.progressSent = true;
+        session.nextProgressAt = now + kProgressUploadInterval;
+        session.uploadsInFlight++;
+        session.progressEvent = m_network->QueueGameProgress(session.serverId, sessionRef,
+            progress.score, progress.leaderboardPoints, progress.skillPoints,
+            progress.survivalTime, progress.livesRemaining, callbackFor(Upload::Progress));
+    }
+}
+
+void SessionJournal::FinishUpload(const std::string& localId, Upload upload, const HttpResponse& response) {
+    Session* session = FindSession(localId);
+    if (!session) return;
+    session->uploadsInFlight--;
+    if (upload == Upload::Progress) {
+        session->progressEvent = 0;
+    }
+
+    if (!response.success) {
+        if (upload == Upload::Progress) {
+            session->progressSent = false;
+            session->nextProgressAt = 0.0;
+        }
+
+        if (IsPermanentFailure(response)) {
+            std::cout << "Server rejected session " << localId << " (" << response.error
+                      << "), dropping it from the journal" << std::endl;
+            m_sessions.erase(m_sessions.begin() + (session - m_sessions.data()));
+            Compact();
+            return;
+        }
+
+        // A save cancelled by RecordEnd isn't a failure (session/end goes out next),
+        // and the first error is the cause of any that follow it
+        if ((upload != Upload::Progress || !session->ended) && session->uploadError.empty()) {
+            session->uploadError = response.error;
+        }
+    } else {
+        switch (upload) {
+            case Upload::Start: {
+                json responseData;
+                if (!DecodeBody(response, responseData)) {
+                    std::cout << "Error parsing session response" << std::endl;
+                } else if (responseData.contains("sessionId") && responseData["sessionId"].is_string()) {
+                    session->serverId = responseData["sessionId"].get<std::string>();
+                }
+                if (session->serverId.empty()) {
+                    std::cout << "Warning: Server did not return session ID, dropping session " << localId << std::endl;
+                    m_sessions.erase(m_sessions.begin() + (session - m_sessions.data()));
+                    Compact();
+                    return;
+                }
+                std::cout << "Game session started successfully! Session ID: " << session->serverId << std::endl;
+                Append(json{ { "event", "bind" }, { "id", localId }, { "server", session->serverId } }.dump());
+                break;
+            }
+            case Upload::Progress:
+                std::cout << "Progress saved successfully!" << std::endl;
+                break;
+            case Upload::End:
+                std::cout << "Game session ended successfully!" << std::endl;
+                m_sessions.erase(m_sessions.begin() + (session - m_sessions.data()));
+                Compact();
+                return;
+        }
+    }
+
+    // Retry timing is decided once everything sent together is back
+    if (session->uploadsInFlight > 0) return;
+    if (session->uploadError.empty()) {
+        session->backoff = 0.0;
+        session->retryAt = 0.0;
+        return;
+    }
+    session->backoff = std::min(std::max(session->backoff * 2.0, kFirstRetryDelay), kMaxRetryDelay);
+    session->retryAt = Now() + session->backoff;
+    std::cout << "Session upload failed (" << session->uploadError << "), retrying in "
+              << session->backoff << " seconds" << std::endl;
+    session->uploadError.clear();
+}
+
+SessionJournal::Session* SessionJournal::FindSession(const std::string& localId) {
+    for (Session& session : m_sessions) {
+        if (session.localId == localId) return &session;
+    }
+    return nullptr;
+}
+
+void SessionJournal::Load() {
+    std::ifstream file(m_path);
+    if (!file.is_open()) return;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+        m_recordCount++;
+        ApplyRecord(line);
+    }
+}
+
+void SessionJournal::ApplyRecord(const std::string& line) {
+    // A crash can tear the last line; it's skipped like any bad record
+    json record = json::parse(line, nullptr, false);
+    if (record.is_discarded() || !record.is_object() || !record.contains("id")) return;
+
+    std::string event = record.value("event", "");
+    std::string localId = record.value("id", "");
+
+    if (event == "start") {
+        if (FindSession(localId)) return;
+        Session session;
+        session.localId = localId;
+        session.seed = std::strtoull(record.value("seed", "0").c_str(), nullptr, 16);
+        session.userId = record.value("user", "");
+        // Older journals kept a token instead; those sessions have no owner
+        if (session.userId.empty()) return;
+        m_sessions.push_back(session);
+        return;
+    }
+
+    Session* session = FindSession(localId);
+    if (!session) return;
+
+    if (event == "bind") {
+        session->serverId = record.value("server", "");
+    } else if (event == "progress") {
+        session->progress = ProgressFromJson(record);
+        session->hasProgress = true;
+    } else if (event == "end") {
+        session->result.progress = ProgressFromJson(record);
+        session->result.kills = record.value("kills", 0);
+        session->result.damageDealt = record.value("damageDealt", 0);
+        session->result.damageTaken = record.value("damageTaken", 0);
+        session->result.waveReached = record.value("waveReached", 0);
+        session->ended = true;
+    }
+}
+
+void SessionJournal::Append(const std::string& line) {
+    if (m_path.empty()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        m_appendBuffer += line;
+        m_appendBuffer += '\n';
+    }
+    m_recordCount++;
+    m_writeReady.notify_one();
+
+    if (m_recordCount >= kCompactThreshold + m_sessions.size() * 4) {
+        Compact();
+    }
+}
+
+void SessionJournal::Compact() {
+    if (m_path.empty()) return;
+
+    // The fewest records that rebuild every unfinished session
+    std::string content;
+    size_t records = 0;
+    for (const Session& session : m_sessions) {
+        content += json{ { "event", "start" }, { "id", session.localId }, { "seed", ToHex(session.seed) },
+                         { "user", session.userId } }.dump() + '\n';
+        records++;
+        if (!session.serverId.empty()) {
+            content += json{ { "event", "bind" }, { "id", session.localId }, { "server", session.serverId } }.dump() + '\n';
+            records++;
+        }
+        if (session.hasProgress) {
+            json record = ProgressToJson(session.progress);
+            record["event"] = "progress";
+            record["id"] = session.localId;
+            content += record.dump() + '\n';
+            records++;
+        }
+        if (session.ended) {
+            const SessionResult& result = session.result;
+            json record = ProgressToJson(result.progress);
+            record["event"] = "end";
+            record["id"] = session.localId;
+            record["kills"] = result.kills;
+            record["damageDealt"] = result.damageDealt;
+            record["damageTaken"] = result.damageTaken;
+            record["waveReached"] = result.waveReached;
+            content += record.dump() + '\n';
+            records++;
+        }
+    }
+
+    {
+        // Supersedes every append not yet written
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        m_rewrite = std::move(content);
+        m_rewritePending = true;
+        m_appendBuffer.clear();
+    }
+    m_recordCount = records;
+    m_writeReady.notify_one();
+}
+
+void SessionJournal::WriterLoop() {
+    std::unique_lock<std::mutex> lock(m_writeMutex);
+    for (;;) {
+        m_writeReady.wait(lock, [this]() {
+            return !m_writerRunning || m_rewritePending || !m_appendBuffer.empty();
+        });
+
+        // Let a burst of records share one fsync
+        if (m_writerRunning) {
+            m_writeReady.wait_for(lock, kWriteBatchWindow, [this]() { return !m_writerRunning; });
+        }
+
+        std::string append;
+        append.swap(m_appendBuffer);
+        std::string rewrite;
+        bool rewritePending = m_rewritePending;
+        rewrite.swap(m_rewrite);
+        m_rewritePending = false;
+        bool running = m_writerRunning;
+        lock.unlock();
+
+        bool rewriteFailed = false;
+        if (rewritePending) {
+            // Records appended since the rewrite was queued follow it
+            rewrite += append;
+            append.clear();
+            rewriteFailed = !Rewrite(rewrite);
+        }
+
+        if (!append.empty()) {
+            FILE* file = std::fopen(m_path.c_str(), "ab");
+            bool written = file && std::fwrite(append.data(), 1, append.size(), file) == append.size();
+            written = file && SyncFile(file) && written;
+            if (file) std::fclose(file);
+            if (!written) {
+                std::cerr << "Failed to write session journal " << m_path << std::endl;
+            }
+        }
+
+        lock.lock();
+        if (rewriteFailed) {
+            // The old file still has sessions the server already has, so
+            // nothing goes into it; newer appends wait for the retry
+            std::cerr << "Failed to compact session journal " << m_path << std::endl;
+            if (!running) break;
+            if (!m_rewritePending) {
+                m_rewrite = std::move(rewrite);
+                m_rewritePending = true;
+            }
+            m_writeReady.wait_for(lock, kRewriteRetryDelay, [this]() { return !m_writerRunning; });
+            continue;
+        }
+        if (!running && !m_rewritePending && m_appendBuffer.empty()) break;
+    }
+}
+
+bool SessionJournal::Rewrite(const std::string& content) {
+    // Write then rename, so a crash mid-write keeps the old file
+    std::string temporaryPath = m_path + ".tmp";
+    FILE* file = std::fopen(temporaryPath.c_str(), "wb");
+    bool written = file && std::fwrite(content.data(), 1, content.size(), file) == content.size();
+    written = file && SyncFile(file) && written;
+    if (file) std::fclose(file);
+    if (!written || !ReplaceJournalFile(temporaryPath, m_path)) {
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
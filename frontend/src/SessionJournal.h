@@ -0,0 +1,115 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <cstdint>
+#include "NetworkManager.h"
+#include "ProgressSync.h"
+#include "WireFormat.h"
+
+class HttpClient;
+class AuthNetworkManager;
+
+// Write-ahead log of game session events, and the uploader that replays
+// it to the server.
+//
+// Session start, progress and end are appended to a JSON-lines file in the
+// user data directory before anything goes over the network, so a run
+// played offline or cut short by a crash still reaches the server later.
+// Sessions get a local id when they start; the server's id is logged once
+// session/start succeeds. The file records whose session it is, never a
+// token: sessions upload with the signed-in user's current token, and
+// another user's sessions wait until that user signs in again. Each
+// session then uploads only its newest progress, at most every
+// kProgressUploadInterval seconds, and its end once recorded; failures
+// back off and retry for as long as the game runs, and on the next
+// launch. Sessions whose end the server acknowledged are compacted out of
+// the file.
+//
+// Appends return immediately: a writer thread batches them and fsyncs.
+// Uploads go out as batched game events driven by Update() on the main
+// thread; a session the server doesn't know yet sends its start and its
+// end or progress in the same batch.
+class SessionJournal {
+public:
+    explicit SessionJournal(HttpClient* client);
+    ~SessionJournal();
+
+    // Loads unfinished sessions from 'path' and starts the writer
+    bool Open(const std::string& path);
+    void SetBaseUrl(const std::string& baseUrl);
+    void SetTimeout(int timeoutMs);
+    void SetWireFormat(WireFormat format);
+
+    // The signed-in user; new sessions belong to them
+    void SetUser(const std::string& userId, const std::string& authToken);
+
+    // Returns the new session's local id, or an empty one if nobody is
+    // signed in (nothing is recorded then)
+    std::string BeginSession(uint64_t seed);
+    void RecordProgress(const std::string& localId, const ProgressSnapshot& progress);
+    void RecordEnd(const std::string& localId, const SessionResult& result);
+
+    // Starts whatever uploads are due; call once per frame
+    void Update();
+
+    // Sessions the server hasn't fully received yet
+    size_t GetUnsentCount() const { return m_sessions.size(); }
+
+private:
+    // Progress is safe in the journal, so the server needn't see every save
+    static constexpr double kProgressUploadInterval = 30.0;
+
+    enum class Upload { Start, Progress, End };
+
+    struct Session {
+        std::string localId;
+        uint64_t seed = 0;
+        std::string userId;
+        std::string serverId;           // Empty until session/start succeeds
+
+        ProgressSnapshot progress;
+        bool hasProgress = false;
+        bool progressSent = false;      // The server has the newest progress
+
+        SessionResult result;
+        bool ended = false;
+
+        int uploadsInFlight = 0;
+        std::string uploadError;        // Set when one of them failed
+        uint64_t progressEvent = 0;     // Queued progress, cancelled by an end
+        double nextProgressAt = 0.0;
+        double retryAt = 0.0;           // Seconds on the steady clock
+        double backoff = 0.0;
+    };
+
+    std::unique_ptr<AuthNetworkManager> m_network;
+    std::string m_userId;
+    std::vector<Session> m_sessions;    // Unfinished, oldest first
+    std::string m_path;
+    size_t m_recordCount;               // Lines in the file
+
+    // Writer thread; appends and rewrites are done in submission order
+    std::thread m_writer;
+    std::mutex m_writeMutex;
+    std::condition_variable m_writeReady;
+    std::string m_appendBuffer;
+    std::string m_rewrite;              // Replaces the whole file when set
+    bool m_rewritePending;
+    bool m_writerRunning;
+
+    Session* FindSession(const std::string& localId);
+    void Load();
+    void ApplyRecord(const std::string& line);
+    void Append(const std::string& line);
+    void Compact();
+    void WriterLoop();
+    bool Rewrite(const std::string& content);
+
+    void StartUpload(Session& session, double now);
+    void FinishUpload(const std::string& localId, Upload upload, const HttpResponse& response);
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <atomic>
+
+// Double-buffered render snapshot for pipelined mode.
+//
+// The simulation thread fills GetWriteBuffer() and calls Publish(); the main
+// thread draws from GetReadBuffer(). The writer always fills the buffer the
+// reader isn't using, so neither side blocks. Game joins the two threads
+// once per frame, which is what keeps a publish from landing mid-draw.
+template <typename T>
+class SnapshotBuffer {
+public:
+    T& GetWriteBuffer() { return m_buffers[1 - m_front.load(std::memory_order_acquire)]; }
+    const T& GetReadBuffer() const { return m_buffers[m_front.load(std::memory_order_acquire)]; }
+
+    // Makes the write buffer the one readers see
+    void Publish() { m_front.store(1 - m_front.load(std::memory_order_relaxed), std::memory_order_release); }
+
+private:
+    T m_buffers[2];
+    std::atomic<int> m_front{0};
+};
@@ -0,0 +1,112 @@
+#include "SpatialHash.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialHash::SpatialHash(float cellSize)
+    : m_cellSize(1.0f)
+    , m_inverseCellSize(1.0f)
+    , m_maxRadius(0.0f)
+    , m_bucketMask(0)
+{
+    SetCellSize(cellSize);
+}
+
+void SpatialHash::SetCellSize(float cellSize) {
+    m_cellSize = cellSize > 0.0f ? cellSize : 1.0f;
+    m_inverseCellSize = 1.0f / m_cellSize;
+    Clear();
+}
+
+void SpatialHash::Clear() {
+    m_items.clear();
+    m_sorted.clear();
+    m_bucketStart.clear();
+    m_maxRadius = 0.0f;
+}
+
+void SpatialHash::Reserve(size_t count) {
+    m_items.reserve(count);
+    m_sorted.reserve(count);
+    
+    // Bucket table Build() will want for that many items
+    size_t bucketCount = 16;
+    while (bucketCount < count * 2) {
+        bucketCount <<= 1;
+    }
+    m_bucketStart.reserve(bucketCount + 1);
+}
+
+void SpatialHash::Insert(int id, float x, float y, float radius) {
+    m_items.emplace_back();
+    Set(m_items.size() - 1, id, x, y, radius);
+}
+
+void SpatialHash::Resize(size_t count) {
+    m_items.resize(count);
+}
+
+void SpatialHash::Set(size_t slot, int id, float x, float y, float radius) {
+    Item& item = m_items[slot];
+    item.x = x;
+    item.y = y;
+    item.radius = radius;
+    item.id = id;
+    item.cellX = CellCoord(x);
+    item.cellY = CellCoord(y);
+}
+
+void SpatialHash::Build() {
+    // Twice as many buckets as items (power of two) keeps collisions rare
+    uint32_t bucketCount = 16;
+    while (bucketCount < m_items.size() * 2) {
+        bucketCount <<= 1;
+    }
+    m_bucketMask = bucketCount - 1;
+
+    // Counting sort: histogram, exclusive prefix sum, scatter
+    m_bucketStart.assign(bucketCount + 1, 0);
+    m_maxRadius = 0.0f;
+    for (const Item& item : m_items) {
+        m_bucketStart[BucketFor(item.cellX, item.cellY) + 1]++;
+        m_maxRadius = std::max(m_maxRadius, item.radius);
+    }
+    for (uint32_t b = 0; b < bucketCount; ++b) {
+        m_bucketStart[b + 1] += m_bucketStart[b];
+    }
+
+    m_sorted.resize(m_items.size());
+    for (const Item& item : m_items) {
+        // Bucket starts double as write cursors, leaving each one at the end
+        // of its bucket; shifted back into place below
+        m_sorted[m_bucketStart[BucketFor(item.cellX, item.cellY)]++] = item;
+    }
+    for (uint32_t b = bucketCount; b > 0; --b) {
+        m_bucketStart[b] = m_bucketStart[b - 1];
+    }
+    m_bucketStart[0] = 0;
+}
+
+int SpatialHash::FindNearest(float x, float y, float maxDistance) const {
+    int nearest = -1;
+    float bestDistanceSq = maxDistance * maxDistance;
+
+    ForEachInRange(x, y, maxDistance, [&](const Item& item) {
+        float distanceSq = Math2D::DistanceSquared(Vec2(item.x, item.y), Vec2(x, y));
+        if (distanceSq <= bestDistanceSq) {
+            bestDistanceSq = distanceSq;
+            nearest = item.id;
+        }
+    });
+
+    return nearest;
+}
+
+int32_t SpatialHash::CellCoord(float v) const {
+    return static_cast<int32_t>(std::floor(v * m_inverseCellSize));
+}
+
+uint32_t SpatialHash::BucketFor(int32_t cellX, int32_t cellY) const {
+    // Large primes mix neighbouring cells into unrelated buckets
+    uint32_t h = (static_cast<uint32_t>(cellX) * 73856093u) ^ (static_cast<uint32_t>(cellY) * 19349663u);
+    return h & m_bucketMask;
+}
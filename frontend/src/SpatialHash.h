@@ -0,0 +1,122 @@
+#pragma once
+
+#include "Math2D.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Uniform grid broadphase for circles.
+//
+// Items are inserted by their center with the caller's index as id, then
+// Build() buckets them by hashed cell with a counting sort. The grid is
+// meant to be rebuilt every simulation tick; all storage is reused, so a
+// rebuild doesn't allocate once capacity has grown to the entity count.
+// Cells are hashed, so the world doesn't need bounds and off-screen
+// entities are fine.
+class SpatialHash {
+public:
+    explicit SpatialHash(float cellSize = 64.0f);
+    ~SpatialHash() = default;
+
+    // Cell size should be around the diameter of the typical item
+    void SetCellSize(float cellSize);
+    float GetCellSize() const { return m_cellSize; }
+
+    void Clear();
+    void Reserve(size_t count);
+    void Insert(int id, float x, float y, float radius);
+    void Build();
+
+    // Parallel fill: Resize() once, then Set() every slot (from any thread,
+    // one writer per slot) before Build()
+    void Resize(size_t count);
+    void Set(size_t slot, int id, float x, float y, float radius);
+
+    size_t GetCount() const { return m_items.size(); }
+
+    // Calls fn(id) for every item whose circle overlaps the query circle
+    template <typename Fn>
+    void QueryCircle(float x, float y, float radius, Fn&& fn) const;
+
+    // Id of the item whose center is nearest to (x, y) within maxDistance,
+    // or -1 if there is none
+    int FindNearest(float x, float y, float maxDistance) const;
+
+    // Calls fn(idA, idB) once for every pair of overlapping items
+    template <typename Fn>
+    void ForEachPair(Fn&& fn) const;
+
+private:
+    struct Item {
+        float x, y;
+        float radius;
+        int id;
+        int32_t cellX, cellY;
+    };
+
+    float m_cellSize;
+    float m_inverseCellSize;
+    float m_maxRadius;
+
+    std::vector<Item> m_items;        // Insertion order
+    std::vector<Item> m_sorted;       // Grouped by bucket after Build()
+    std::vector<uint32_t> m_bucketStart; // Bucket b spans [start[b], start[b + 1])
+    uint32_t m_bucketMask;
+
+    int32_t CellCoord(float v) const;
+    uint32_t BucketFor(int32_t cellX, int32_t cellY) const;
+
+    // Visits the items stored in every cell overlapping the square around
+    // (x, y) with the given half extent
+    template <typename Fn>
+    void ForEachInRange(float x, float y, float extent, Fn&& fn) const;
+};
+
+template <typename Fn>
+void SpatialHash::ForEachInRange(float x, float y, float extent, Fn&& fn) const {
+    if (m_sorted.empty()) return;
+
+    int32_t minX = CellCoord(x - extent);
+    int32_t maxX = CellCoord(x + extent);
+    int32_t minY = CellCoord(y - extent);
+    int32_t maxY = CellCoord(y + extent);
+
+    for (int32_t cy = minY; cy <= maxY; ++cy) {
+        for (int32_t cx = minX; cx <= maxX; ++cx) {
+            uint32_t bucket = BucketFor(cx, cy);
+            for (uint32_t i = m_bucketStart[bucket]; i < m_bucketStart[bucket + 1]; ++i) {
+                const Item& item = m_sorted[i];
+                // Buckets are shared between cells; skip items from other cells
+                // so nothing is visited twice
+                if (item.cellX == cx && item.cellY == cy) {
+                    fn(item);
+                }
+            }
+        }
+    }
+}
+
+template <typename Fn>
+void SpatialHash::QueryCircle(float x, float y, float radius, Fn&& fn) const {
+    Vec2 center(x, y);
+    ForEachInRange(x, y, radius + m_maxRadius, [&](const Item& item) {
+        if (Math2D::CirclesOverlap(center, radius, Vec2(item.x, item.y), item.radius)) {
+            fn(item.id);
+        }
+    });
+}
+
+template <typename Fn>
+void SpatialHash::ForEachPair(Fn&& fn) const {
+    for (size_t a = 0; a < m_sorted.size(); ++a) {
+        const Item& first = m_sorted[a];
+        ForEachInRange(first.x, first.y, first.radius + m_maxRadius, [&](const Item& second) {
+            // Report each pair once, from the item earlier in sorted order
+            if (&second <= &first) return;
+
+            if (Math2D::CirclesOverlap(Vec2(first.x, first.y), first.radius, Vec2(second.x, second.y), second.radius)) {
+                fn(first.id, second.id);
+            }
+        });
+    }
+}
@@ -0,0 +1,47 @@
+#include "Viewport.h"
+#include <algorithm>
+
+Viewport::Viewport() {
+    UpdateWorld();
+}
+
+void Viewport::SetWindowSize(int width, int height) {
+    m_windowWidth = std::max(width, 1);
+    m_windowHeight = std::max(height, 1);
+    UpdateWorld();
+}
+
+void Viewport::SetRenderScale(float scale) {
+    m_renderScale = std::min(std::max(scale, 0.25f), 1.0f);
+}
+
+int Viewport::GetRenderWidth() const {
+    return std::max(static_cast<int>(m_windowWidth * m_renderScale + 0.5f), 1);
+}
+
+int Viewport::GetRenderHeight() const {
+    return std::max(static_cast<int>(m_windowHeight * m_renderScale + 0.5f), 1);
+}
+
+float Viewport::WindowToWorldX(float x) const {
+    return x * m_worldWidth / m_windowWidth;
+}
+
+float Viewport::WindowToWorldY(float y) const {
+    return y * m_worldHeight / m_windowHeight;
+}
+
+void Viewport::UpdateWorld() {
+    // Fixed design height; width follows the window's aspect ratio
+    m_worldHeight = kDesignHeight;
+    m_worldWidth = kDesignHeight * m_windowWidth / m_windowHeight;
+
+    // Same matrix glOrtho(0, w, h, 0, -1, 1) would build
+    std::fill(m_projection, m_projection + 16, 0.0f);
+    m_projection[0] = 2.0f / m_worldWidth;
+    m_projection[5] = -2.0f / m_worldHeight;
+    m_projection[10] = -1.0f;
+    m_projection[12] = -1.0f;
+    m_projection[13] = 1.0f;
+    m_projection[15] = 1.0f;
+}
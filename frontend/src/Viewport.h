@@ -0,0 +1,48 @@
+#pragma once
+
+// Owns the mapping between the logical game world and the window.
+// The world is always kDesignHeight units tall and as wide as the window's
+// aspect ratio allows, so gameplay bounds stay consistent at any window size.
+// The scene can be rendered at a fraction of the window resolution
+// (render scale) and upscaled by the Renderer.
+class Viewport {
+public:
+    static constexpr float kDesignWidth = 1280.0f;
+    static constexpr float kDesignHeight = 720.0f;
+
+    Viewport();
+    ~Viewport() = default;
+
+    // Window size in pixels (drawable size)
+    void SetWindowSize(int width, int height);
+    int GetWindowWidth() const { return m_windowWidth; }
+    int GetWindowHeight() const { return m_windowHeight; }
+
+    // Internal resolution as a fraction of the window, clamped to [0.25, 1]
+    void SetRenderScale(float scale);
+    float GetRenderScale() const { return m_renderScale; }
+    bool IsScaled() const { return m_renderScale < 1.0f; }
+    int GetRenderWidth() const;
+    int GetRenderHeight() const;
+
+    // World bounds exposed to game states
+    float GetWorldWidth() const { return m_worldWidth; }
+    float GetWorldHeight() const { return m_worldHeight; }
+
+    // Window pixel -> world unit conversion (mouse input)
+    float WindowToWorldX(float x) const;
+    float WindowToWorldY(float y) const;
+
+    // Column-major orthographic projection, (0,0) top-left of the world
+    const float* GetProjection() const { return m_projection; }
+
+private:
+    int m_windowWidth = static_cast<int>(kDesignWidth);
+    int m_windowHeight = static_cast<int>(kDesignHeight);
+    float m_renderScale = 1.0f;
+    float m_worldWidth = kDesignWidth;
+    float m_worldHeight = kDesignHeight;
+    float m_projection[16] = {};
+
+    void UpdateWorld();
+};
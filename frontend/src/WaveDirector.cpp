@@ -0,0 +1,170 @@
+#include "WaveDirector.h"
+#include "GameConfig.h"
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+namespace {
+// Enemies per second in the first wave before spawn_rate_multiplier (the
+// rate the game had before waves)
+constexpr float kBaseEnemiesPerSecond = 2.0f;
+
+// Delay between overdue enemies, and before retrying while the cap is reached
+constexpr float kCapRetryDelay = 0.25f;
+}
+
+WaveSettings WaveSettings::FromConfig(const GameConfig& config) {
+    WaveSettings settings;
+    settings.baseDuration = config.waves.baseDuration;
+    settings.difficultyScaling = config.waves.difficultyScaling;
+    settings.bossEvery = config.waves.bossEvery;
+    settings.enemyCountMultiplier = config.waves.enemyCountMultiplier;
+    settings.spawnRateMultiplier = config.enemies.spawnRateMultiplier;
+    settings.maxEnemies = static_cast<size_t>(config.enemies.maxEnemies);
+    settings.maxPowerUps = static_cast<size_t>(config.powerUps.maxActive);
+    settings.powerUpInterval = config.powerUps.interval;
+    return settings;
+}
+
+WaveDirector::WaveDirector()
+    : m_wave(0)
+    , m_overdueEnemies(0)
+    , m_overdueBosses(0)
+{
+    // A wave start, the enemy streams of the current and the ending wave, a
+    // boss, the overdue event and the power-up timer: never more than a few
+    // events at once
+    std::vector<Event> storage;
+    storage.reserve(16);
+    m_events = std::priority_queue<Event, std::vector<Event>, Later>(Later(), std::move(storage));
+    Reset();
+}
+
+void WaveDirector::SetSettings(const WaveSettings& settings) {
+    m_settings = settings;
+    Reset();
+}
+
+void WaveDirector::Reset() {
+    while (!m_events.empty()) {
+        m_events.pop();
+    }
+    m_wave = 0;
+    m_overdueEnemies = 0;
+    m_overdueBosses = 0;
+    
+    Schedule({ 0.0f, EventType::WaveStart, 1, 0, 0.0f });
+    Schedule({ m_settings.powerUpInterval, EventType::PowerUp, 0, 0, 0.0f });
+}
+
+size_t WaveDirector::Update(float gameTime, size_t enemyCount, size_t powerUpCount, Spawn* out, size_t maxSpawns) {
+    size_t count = 0;
+    
+    while (!m_events.empty() && m_events.top().time <= gameTime) {
+        Event event = m_events.top();
+        
+        // Wave starts only schedule, so they never wait on the spawn budget
+        if (event.type == EventType::WaveStart) {
+            m_events.pop();
+            StartWave(event);
+            continue;
+        }
+        if (count == maxSpawns) break;
+        m_events.pop();
+        
+        switch (event.type) {
+            case EventType::Enemy:
+            case EventType::Boss:
+                if (enemyCount < m_settings.maxEnemies) {
+                    out[count++] = { event.type == EventType::Boss ? SpawnKind::Boss : SpawnKind::Enemy,
+                                     event.wave, GetSpeedScale(event.wave) };
+                    enemyCount++;
+                } else {
+                    // Everything this stream has due by now is owed in one go,
+                    // and it resumes after this tick (late waves' intervals
+                    // can be below float precision)
+                    int owed = 1;
+                    if (event.type == EventType::Enemy && event.interval > 0.0f) {
+                        float behind = (gameTime - event.time) / event.interval;
+                        owed += behind < event.remaining ? static_cast<int>(behind) : event.remaining;
+                    }
+                    Owe(event.type == EventType::Boss, owed, gameTime);
+                    if (event.type == EventType::Enemy && event.remaining >= owed) {
+                        event.remaining -= owed;
+                        event.time = std::max(event.time + event.interval * owed,
+                                              std::nextafter(gameTime, gameTime + 1.0f));
+                        Schedule(event);
+                    }
+                    break;
+                }
+                
+                if (event.type == EventType::Enemy && event.remaining > 0) {
+                    event.time += event.interval;
+                    event.remaining--;
+                    Schedule(event);
+                }
+                break;
+                
+            case EventType::PowerUp:
+                if (powerUpCount < m_settings.maxPowerUps) {
+                    out[count++] = { SpawnKind::PowerUp, m_wave, 1.0f };
+                    powerUpCount++;
+                }
+                event.time += m_settings.powerUpInterval;
+                Schedule(event);
+                break;
+                
+            case EventType::Overdue:
+                if (enemyCount < m_settings.maxEnemies) {
+                    // Bosses first; they matter more than one more enemy
+                    bool boss = m_overdueBosses > 0;
+                    (boss ? m_overdueBosses : m_overdueEnemies)--;
+                    out[count++] = { boss ? SpawnKind::Boss : SpawnKind::Enemy, m_wave, GetSpeedScale(m_wave) };
+                    enemyCount++;
+                }
+                if (m_overdueEnemies + m_overdueBosses > 0) {
+                    event.time = gameTime + kCapRetryDelay;
+                    Schedule(event);
+                }
+                break;
+                
+            case EventType::WaveStart:
+                break;
+        }
+    }
+    return count;
+}
+
+void WaveDirector::StartWave(const Event& event) {
+    int wave = event.wave;
+    m_wave = wave;
+    
+    float duration = m_settings.baseDuration;
+    float enemies = kBaseEnemiesPerSecond * m_settings.spawnRateMultiplier * duration *
+                    std::pow(m_settings.enemyCountMultiplier, static_cast<float>(wave - 1));
+    int enemyCount = std::max(static_cast<int>(enemies + 0.5f), 1);
+    
+    std::cout << "Wave " << wave << ": " << enemyCount << " enemies over " << duration << "s" << std::endl;
+    
+    // One stream event walks through the wave's enemies
+    Schedule({ event.time, EventType::Enemy, wave, enemyCount - 1, duration / enemyCount });
+    if (m_settings.bossEvery > 0 && wave % m_settings.bossEvery == 0) {
+        Schedule({ event.time, EventType::Boss, wave, 0, 0.0f });
+    }
+    Schedule({ event.time + duration, EventType::WaveStart, wave + 1, 0, 0.0f });
+}
+
+void WaveDirector::Owe(bool boss, int count, float gameTime) {
+    // One overdue event serves everything owed
+    if (m_overdueEnemies + m_overdueBosses == 0) {
+        Schedule({ gameTime + kCapRetryDelay, EventType::Overdue, 0, 0, 0.0f });
+    }
+    // Saturates rather than overflowing when the player stalls for many waves
+    int& owed = boss ? m_overdueBosses : m_overdueEnemies;
+    owed = count < std::numeric_limits<int>::max() - owed ? owed + count : std::numeric_limits<int>::max();
+}
+
+float WaveDirector::GetSpeedScale(int wave) const {
+    return std::pow(m_settings.difficultyScaling, static_cast<float>(wave - 1));
+}
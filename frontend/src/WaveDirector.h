@@ -0,0 +1,96 @@
+#pragma once
+
+#include <queue>
+#include <vector>
+#include <cstddef>
+
+struct GameConfig;
+
+// Spawn schedule tunables, taken from the waves, enemies and power_ups
+// blocks of the game config
+struct WaveSettings {
+    float baseDuration = 30.0f;         // Seconds per wave
+    float difficultyScaling = 1.15f;    // Enemy speed multiplier per wave
+    int bossEvery = 5;                  // Boss at the start of every Nth wave (0 = never)
+    float enemyCountMultiplier = 1.2f;  // Enemy count growth per wave
+    float spawnRateMultiplier = 1.0f;   // Scales enemies per second
+    size_t maxEnemies = 50;             // Live enemy cap, bosses included
+    size_t maxPowerUps = 32;
+    float powerUpInterval = 5.0f;       // Seconds between power-ups
+
+    static WaveSettings FromConfig(const GameConfig& config);
+};
+
+// Schedules spawns as timed events.
+//
+// Waves start every baseDuration seconds and spread their enemies evenly
+// across the wave. Each pending stream (next enemy of a wave, next wave,
+// next power-up) is one event in a time-ordered queue, so the queue stays
+// a handful of entries long however large the waves get. Update() hands out
+// at most 'maxSpawns' due spawns; anything beyond that stays queued for the
+// next tick, so catching up after a stall never bursts in one frame.
+// Enemies due while the cap is reached are owed instead: their stream
+// keeps its pace, and a single overdue event hands them out as room frees
+// up (at the speed of the wave current by then), so a player who falls
+// behind doesn't leave a stream per wave waiting in the queue.
+class WaveDirector {
+public:
+    enum class SpawnKind {
+        Enemy,
+        Boss,
+        PowerUp
+    };
+
+    struct Spawn {
+        SpawnKind kind;
+        int wave;
+        float speedScale;   // difficultyScaling^(wave - 1)
+    };
+
+    WaveDirector();
+
+    void SetSettings(const WaveSettings& settings);
+    const WaveSettings& GetSettings() const { return m_settings; }
+
+    // Back to wave 0 at time 0
+    void Reset();
+
+    // Writes the spawns due by gameTime into out (at most maxSpawns) and
+    // returns how many were written
+    size_t Update(float gameTime, size_t enemyCount, size_t powerUpCount, Spawn* out, size_t maxSpawns);
+
+    int GetWave() const { return m_wave; }
+
+private:
+    enum class EventType {
+        WaveStart,
+        Enemy,
+        Boss,
+        PowerUp,
+        Overdue
+    };
+
+    struct Event {
+        float time;
+        EventType type;
+        int wave;
+        int remaining;      // Enemy events: spawns left in this wave after this one
+        float interval;     // Enemy events: time to the next one
+    };
+
+    // Earliest event on top
+    struct Later {
+        bool operator()(const Event& a, const Event& b) const { return a.time > b.time; }
+    };
+
+    WaveSettings m_settings;
+    std::priority_queue<Event, std::vector<Event>, Later> m_events;
+    int m_wave;
+    int m_overdueEnemies;   // Due while the cap was reached
+    int m_overdueBosses;
+
+    void Schedule(const Event& event) { m_events.push(event); }
+    void StartWave(const Event& event);
+    void Owe(bool boss, int count, float gameTime);
+    float GetSpeedScale(int wave) const;
+};
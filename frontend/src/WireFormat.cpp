@@ -0,0 +1,84 @@
+#include "WireFormat.h"
+#include "NetworkManager.h"
+#include <nlohmann/json.hpp>
+#include <zlib.h>
+
+using json = nlohmann::json;
+
+namespace {
+const char* const kJsonType = "application/json";
+const char* const kMessagePackType = "application/msgpack";
+const char* const kCborType = "application/cbor";
+
+// Content-Type may carry parameters ("application/json; charset=utf-8")
+bool HasMediaType(const std::string& contentType, const char* mediaType) {
+    std::string::size_type length = std::char_traits<char>::length(mediaType);
+    if (contentType.compare(0, length, mediaType) != 0) return false;
+    return contentType.size() == length || contentType[length] == ';' || contentType[length] == ' ';
+}
+}
+
+bool ParseWireFormat(const std::string& name, WireFormat& format) {
+    if (name == "json") {
+        format = WireFormat::Json;
+    } else if (name == "msgpack") {
+        format = WireFormat::MessagePack;
+    } else if (name == "cbor") {
+        format = WireFormat::Cbor;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* GetContentType(WireFormat format) {
+    switch (format) {
+        case WireFormat::MessagePack: return kMessagePackType;
+        case WireFormat::Cbor: return kCborType;
+        case WireFormat::Json: break;
+    }
+    return kJsonType;
+}
+
+std::string EncodeBody(const json& body, WireFormat format) {
+    if (format == WireFormat::Json) {
+        return body.dump();
+    }
+
+    std::string encoded;
+    if (format == WireFormat::MessagePack) {
+        json::to_msgpack(body, nlohmann::detail::output_adapter<char>(encoded));
+    } else {
+        json::to_cbor(body, nlohmann::detail::output_adapter<char>(encoded));
+    }
+    return encoded;
+}
+
+bool DecodeBody(const HttpResponse& response, json& body) {
+    const std::string& data = response.data;
+    if (HasMediaType(response.contentType, kMessagePackType)) {
+        body = json::from_msgpack(data.begin(), data.end(), true, false);
+    } else if (HasMediaType(response.contentType, kCborType)) {
+        body = json::from_cbor(data.begin(), data.end(), true, false);
+    } else {
+        body = json::parse(data, nullptr, false);
+    }
+    return !body.is_discarded();
+}
+
+bool GzipCompress(const std::string& input, std::string& output) {
+    z_stream stream = {};
+    // 15 window bits, +16 for a gzip header instead of zlib's
+    if (deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    output.resize(deflateBound(&stream, static_cast<uLong>(input.size())));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&output[0]);
+    stream.avail_out = static_cast<uInt>(output.size());
+    int result = deflate(&stream, Z_FINISH);
+    output.resize(stream.total_out);
+    deflateEnd(&stream);
+    return result == Z_STREAM_END;
+}
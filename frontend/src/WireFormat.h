@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <nlohmann/json_fwd.hpp>
+
+struct HttpResponse;
+
+// Body encodings for game telemetry requests (sessions, progress, batches).
+//
+// The binary formats carry the same document as the JSON one in fewer
+// bytes and with cheaper encoding. The request's Content-Type names the
+// encoding, and the server answers in the same one when asked via Accept;
+// other endpoints stay JSON.
+enum class WireFormat { Json, MessagePack, Cbor };
+
+// "json", "msgpack" or "cbor"; returns false for anything else
+bool ParseWireFormat(const std::string& name, WireFormat& format);
+const char* GetContentType(WireFormat format);
+
+std::string EncodeBody(const nlohmann::json& body, WireFormat format);
+
+// Parses a response in whichever format its Content-Type names (JSON when
+// it names none); returns false if the body is malformed
+bool DecodeBody(const HttpResponse& response, nlohmann::json& body);
+
+// Bodies below this size aren't worth compressing
+constexpr size_t kCompressThreshold = 1024;
+
+// gzip, as the server's body parsers inflate it
+bool GzipCompress(const std::string& input, std::string& output);
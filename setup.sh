@@ -37,6 +37,7 @@ install_dependencies() {
                     libglew-dev \
                     libglm-dev \
                     libcurl4-openssl-dev \
+                    zlib1g-dev \
                     git
             # Fedora/RHEL
             elif command -v dnf &> /dev/null; then
@@ -50,6 +51,7 @@ install_dependencies() {
                     glew-devel \
                     glm-devel \
                     libcurl-devel \
+                    zlib-devel \
                     git
             # Arch Linux
             elif command -v pacman &> /dev/null; then
@@ -63,6 +65,7 @@ install_dependencies() {
                     glew \
                     glm \
                     curl \
+                    zlib \
                     git
             else
                 echo "❌ Unknown Linux distribution. Please install dependencies manually."
@@ -86,6 +89,7 @@ install_dependencies() {
                 glew \
                 glm \
                 curl \
+                zlib \
                 git
             ;;
         "windows")
@@ -94,13 +98,14 @@ install_dependencies() {
             echo "  - GLEW"
             echo "  - GLM"
             echo "  - libcurl"
+            echo "  - zlib"
             echo "  - CMake"
             echo "  - Visual Studio 2019+ or MinGW"
             echo ""
             echo "Example with vcpkg:"
             echo "  git clone https://github.com/Microsoft/vcpkg.git"
             echo "  .\\vcpkg\\bootstrap-vcpkg.bat"
-            echo "  .\\vcpkg\\vcpkg install sdl2 glew glm curl"
+            echo "  .\\vcpkg\\vcpkg install sdl2 glew glm curl zlib"
             exit 0
             ;;
     esac